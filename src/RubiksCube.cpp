@@ -3,14 +3,7 @@
 #include <cmath>
 
 bool RubiksCube::isSolved() const {
-    for (int i = 0; i < 26; i++) {
-        if (cubeletPos[i] != solvedPosition[i]) {
-            // finds a piece that isnt correct
-            return false;
-        }
-    }
-    // All pieces are correct
-    return true;
+    return state.isSolved();
 }
 
 void RubiksCube::initNumbering() {
@@ -22,14 +15,12 @@ void RubiksCube::initNumbering() {
                 // Skip Center
                 if (x ==0 && y == 0 && z == 0) continue;
 
-                glm::ivec3 pos(x, y, z);
-
                 // Piece 1, 2, 3, ...
                 cubeletID[id] = id;
                 // Where cubelet is now
-                cubeletPos[id] = pos;
+                cubeletPos[id] = toIvec(state.getPiece(id).pos);
                 // Where cubelet belongs
-                solvedPosition[id] = pos;
+                solvedPosition[id] = toIvec(state.getSolvedPosition(id));
 
                 id++;
             }
@@ -37,50 +28,41 @@ void RubiksCube::initNumbering() {
     }
 }
 
-// --- Helper: Get Initial Colors for a Cubie ---
-std::vector<color> RubiksCube::getInitialColors(int x, int y, int z) {
-    // Face color mapping (0:Front, 1:Back, 2:Right, 3:Left, 4:Top, 5:Bottom)
-    std::vector<color> colors(6, BLACK); // Default to BLACK for internal faces
-
-    // Front/Back (Z-Axis)
-    if (z == 1) colors[FRONT] = BLUE;    // Front face (Z=1) is BLUE
-    if (z == -1) colors[BACK] = GREEN;  // Back face (Z=-1) is GREEN
-
-    // Right/Left (X-Axis)
-    if (x == 1) colors[RIGHT] = RED;     // Right face (X=-1) is RED
-    if (x == -1) colors[LEFT] = ORANGE; // Left face (X=1) is ORANGE
-
-    // Top/Bottom (Y-Axis)
-    if (y == 1) colors[UP] = WHITE;   // Top face (Y=1) is WHITE
-    if (y == -1) colors[DOWN] = YELLOW; // Bottom face (Y=-1) is YELLOW
+// --- Helper: Render Colors for a Piece ---
+color RubiksCube::toRenderColor(char c) const {
+    switch (c) {
+        case 'W': return WHITE;
+        case 'Y': return YELLOW;
+        case 'B': return BLUE;
+        case 'G': return GREEN;
+        case 'R': return RED;
+        case 'O': return ORANGE;
+        default:  return BLACK; // Internal faces
+    }
+}
 
+std::vector<color> RubiksCube::getRenderColors(int id) const {
+    // Face color mapping (0:Front, 1:Back, 2:Right, 3:Left, 4:Top, 5:Bottom)
+    std::vector<color> colors(6, BLACK);
+    const CubePiece& piece = state.getPiece(id);
+    for (int f = 0; f < 6; f++) {
+        colors[f] = toRenderColor(piece.faces[f]);
+    }
     return colors;
 }
 
 // --- Constructor: Assemble the Cube ---
 RubiksCube::RubiksCube(Shader& shader) : cubeletShader(shader) {
-    // Iterate through all 27 potential positions (-1, 0, 1 for each axis)
-    for (int x = -1; x <= 1; x++) {
-        for (int y = -1; y <= 1; y++) {
-            for (int z = -1; z <= 1; z++) {
-                // Skip the central piece (0, 0, 0)
-                if (x == 0 && y == 0 && z == 0) {
-                    continue;
-                }
-
-                glm::ivec3 gridPos = glm::ivec3(x, y, z);
-                std::vector<color> initialColors = getInitialColors(x, y, z);
-
-                cubelet.push_back(std::make_unique<Cubelet>(
-                    cubeletShader,
-                    gridPos,
-                    glm::vec3(0.95f, 0.95f, 0.95f), // Size: slightly smaller than 1.0 to show gaps
-                    initialColors
-                ));
-                cubeletMap[pack(x, y, z)] = cubelet.back().get();
-
-            }
-        }
+    // One render view per piece of the headless state (ids match initNumbering)
+    for (int id = 0; id < CubeState::PIECE_COUNT; id++) {
+        glm::ivec3 gridPos = toIvec(state.getPiece(id).pos);
+
+        cubelet.push_back(std::make_unique<Cubelet>(
+            cubeletShader,
+            gridPos,
+            glm::vec3(0.95f, 0.95f, 0.95f), // Size: slightly smaller than 1.0 to show gaps
+            getRenderColors(id)
+        ));
     }
     initNumbering();
 }
@@ -105,24 +87,6 @@ glm::vec3 RubiksCube::getWorldPositionFromGrid(glm::ivec3 gridPos) {
     return glm::vec3(gridPos.x * 1.0f, gridPos.y * 1.0f, gridPos.z * 1.0f);
 }
 
-glm::ivec3 RubiksCube::calculateNewGridPosition(glm::ivec3 p, char axis, bool clockwise) {
-    switch(axis)
-    {
-        case 'X':
-            if (clockwise)  return { p.x, -p.z,  p.y };   // (y,z) -> (-z,y)
-            else            return { p.x,  p.z, -p.y };   // (y,z) -> (z,-y)
-
-        case 'Y':
-            if (clockwise)  return {  p.z, p.y, -p.x };   // (x,z) -> (z,-x)
-            else            return { -p.z, p.y,  p.x };   // (x,z) -> (-z,x)
-
-        case 'Z':
-            if (clockwise)  return { -p.y, p.x, p.z };    // (x,y) -> (-y,x)
-            else            return {  p.y, -p.x, p.z };   // (x,y) -> (y,-x)
-    }
-    return p;
-}
-
 // --- Update Function ---
 void RubiksCube::update(float deltaTime) {
 
@@ -136,56 +100,16 @@ void RubiksCube::update(float deltaTime) {
 
         bool clockwise = (currentRotation.totalAngle > 0);
 
-        // Update face colors for all rotating pieces
-        for (Cubelet* piece : rotatingPieces) {
-            if (currentRotation.axis == 'Y') {
-                piece->rotateAroundY(clockwise);
-            } else if (currentRotation.axis == 'X') {
-                piece->rotateAroundX(clockwise);
-            } else if (currentRotation.axis == 'Z') {
-                piece->rotateAroundZ(clockwise);
-            }
-            piece->updateVertexColors(); // Update GPU buffer with new colors
-        }
-
-        // Tempory Position Vectors
-        std::vector<glm::ivec3> oldPosition;
-        std::vector<glm::ivec3> newPosition;
-
-        for (Cubelet* piece : rotatingPieces) {
-            glm::ivec3 oldPos = piece->getGridPosition();
-            glm::ivec3 newPos = calculateNewGridPosition(
-                oldPos,
-                currentRotation.axis,
-                currentRotation.totalAngle > 0
-            );
-            oldPosition.push_back(oldPos);
-            newPosition.push_back(newPos);
-        }
-        // Update Position Tracking
-        for (size_t i = 0; i < oldPosition.size(); i++) {
-            glm::ivec3 oldPos = oldPosition[i];
-            glm::ivec3 newPos = newPosition[i];
-
-            for (int j = 0; j < 26; j++) {
-                if (cubeletPos[j] == oldPos) {
-                    cubeletPos[j] = newPos;
-                    break;
-                }
-            }
-        }
+        // Apply the turn to the headless state, then resync the render views
+        state.applyTurn(currentRotation.axis, currentRotation.layerValue, clockwise);
 
-        for (size_t i = 0; i < rotatingPieces.size(); i++) {
-            rotatingPieces[i] -> setGridPosition(newPosition[i]);
-            rotatingPieces[i] -> updateModelMatrix();
+        for (int id : rotatingPieces) {
+            cubeletPos[id] = toIvec(state.getPiece(id).pos);
+            cubelet[id]->setGridPosition(cubeletPos[id]);
+            cubelet[id]->setFaceColors(getRenderColors(id));
+            cubelet[id]->updateVertexColors(); // Update GPU buffer with new colors
         }
 
-        rebuildPositions();
-        rebuildMap();
-
-
-
-
         // Reset state
         currentRotation.axis = '\0';
         rotatingPieces.clear();
@@ -209,8 +133,8 @@ void RubiksCube::update(float deltaTime) {
 
     glm::mat4 rotationMatrix = glm::rotate(glm::mat4(1.0f), glm::radians(angle), axis);
 
-    for (Cubelet* piece : rotatingPieces) {
-        piece -> rotateLocal(rotationMatrix);
+    for (int id : rotatingPieces) {
+        cubelet[id] -> rotateLocal(rotationMatrix);
     }
 
     currentRotation.currentAngle += std::abs(angleThisFrame);
@@ -230,22 +154,17 @@ void RubiksCube::startRotation(char axis, float layerValue, float angle) {
     currentRotation.currentAngle = 0.0f;
     rotatingPieces.clear();
 
-    // Group the 9 pieces that belong to a layer
-    for (const auto& cubelet : cubelet) {
-        glm::ivec3 pos = cubelet->getGridPosition();
-
-        bool isPieceInLayer = false;
-
-        if (axis == 'X' && std::abs(pos.x - layerValue) < 0.01f) {
-            isPieceInLayer = true;
-        } else if (axis == 'Y' && std::abs(pos.y - layerValue) < 0.01f) {
-            isPieceInLayer = true;
-        } else if (axis == 'Z' && std::abs(pos.z - layerValue) < 0.01f) {
-            isPieceInLayer = true;
-        }
-
-        if (isPieceInLayer) {
-            rotatingPieces.push_back(cubelet.get());
+    // Group the 9 pieces that belong to a layer, read from its slots
+    int layer = currentRotation.layerValue;
+    for (int a = -1; a <= 1; a++) {
+        for (int b = -1; b <= 1; b++) {
+            GridPos slot = (axis == 'X') ? GridPos{layer, a, b}
+                         : (axis == 'Y') ? GridPos{a, layer, b}
+                                         : GridPos{a, b, layer};
+            int id = state.getPieceIdAt(slot);
+            if (id >= 0) {
+                rotatingPieces.push_back(id);
+            }
         }
     }
     // After color rotation, add debug output
@@ -282,35 +201,13 @@ void RubiksCube::debugPositionTracking(const std::vector<glm::ivec3>& oldPositio
 }
 
 
-void RubiksCube::rebuildMap() {
-    cubeletMap.clear();
-    for (const auto& cptr : cubelet) {
-        glm::ivec3 p = cptr-> getGridPosition();
-        cubeletMap[pack(p.x, p.y, p.z)] = cptr.get();
-    }
-}
-void RubiksCube::rebuildPositions() {
-    // Assumes cubelet.size() == 26 and that cubelet order matches initNumbering() order
-    for (size_t i = 0; i < cubelet.size(); ++i) {
-        cubeletPos[i] = cubelet[i]->getGridPosition();
-    }
-}
-
 Cubelet* RubiksCube::getCubelet(glm::ivec3 gridPos) {
-    long long key = pack(gridPos.x, gridPos.y, gridPos.z);
-    auto it = cubeletMap.find(key);
-    if (it != cubeletMap.end()) {
-        return it->second;
-    }
-    return nullptr;
+    int id = state.getPieceIdAt({gridPos.x, gridPos.y, gridPos.z});
+    return id < 0 ? nullptr : cubelet[id].get();
 }
 const Cubelet* RubiksCube::getCubelet(glm::ivec3 gridPos) const {
-    long long key = pack(gridPos.x, gridPos.y, gridPos.z);
-    auto it = cubeletMap.find(key);
-    if (it != cubeletMap.end()) {
-        return it->second;
-    }
-    return nullptr;
+    int id = state.getPieceIdAt({gridPos.x, gridPos.y, gridPos.z});
+    return id < 0 ? nullptr : cubelet[id].get();
 }
 
 
@@ -2,12 +2,12 @@
 #define RUBIKSCUBE_H
 
 #include "shapes/Cubelet.h" // Includes the Cubelet class and necessary GLM headers
+#include "core/CubeState.h"
 #include <vector>
 #include <memory>
 #include <glm/glm.hpp>
 #include <array>
 #include <string>
-#include <unordered_map>
 
 class Solver;
 
@@ -15,19 +15,15 @@ class RubiksCube {
 
     friend class Solver;
 private:
+    // Headless state this class renders; the cubelets below only mirror it
+    CubeState state;
+
     // Give each a permanent id number
     std::array<int,26> cubeletID;
     std::array<int,26> currentOrientation;
     std::array<int,26> solvedOrientation;
 
-    std::unordered_map<long long, Cubelet*> cubeletMap;
-
-    inline long long pack(int x, int y, int z) const {
-        return (long long)((x+2) * 25 + (y+2) * 5 + (z + 2));
-    }
-
-
-    // Track where the ID is located
+    // Track where the ID is located (updated for the turned pieces only)
     std::array<glm::ivec3,26> cubeletPos;
 
     // Track where the position should be
@@ -49,8 +45,8 @@ private:
 
     RotationState currentRotation;
 
-    // Vector to hold the 9 pointers to the Cubelets currently being rotated
-    std::vector<Cubelet*> rotatingPieces;
+    // Ids of the 9 pieces currently being rotated
+    std::vector<int> rotatingPieces;
 
     // Container for the 26 individual pieces
     std::vector<std::unique_ptr<Cubelet>> cubelet;
@@ -65,18 +61,23 @@ private:
     const color ORANGE = color(1.0f, 0.5f, 0.0f);
     const color BLACK = color(0.0f, 0.0f, 0.0f);
 
-    // Helper function to get the initial colors for a cubelet at (x, y, z)
-    std::vector<color> getInitialColors(int x, int y, int z);
+    // Helper function to get the render colors of a piece in the state
+    std::vector<color> getRenderColors(int id) const;
+    color toRenderColor(char c) const;
     glm::vec3 getAxisVector(char axis);
     glm::vec3 getWorldPositionFromGrid(glm::ivec3 gridPos);
-    glm::ivec3 calculateNewGridPosition(glm::ivec3 oldPos, char axis, bool clockwise);
+    static glm::ivec3 toIvec(GridPos p) { return glm::ivec3(p.x, p.y, p.z); }
 
+    // Slot -> piece lookup through the state's flat slot index
     Cubelet* getCubelet(glm::ivec3 gridPos);
     const Cubelet* getCubelet(glm::ivec3 gridPos) const;
 
 public:
 
     bool isSolved() const;
+    const CubeState& getState() const { return state; }
+    // Zobrist hash of the settled state (the move being animated is not in it yet)
+    uint64_t getHash() const { return state.getHash(); }
 
     const std::array<glm::ivec3, 26>& getCurrentPosition() const {return cubeletPos;}
     const std::array<glm::ivec3, 26>& getSolvedPosition() const {return solvedPosition;}
@@ -109,34 +110,16 @@ public:
     void printPosition();
     void debugPositionTracking(const std::vector<glm::ivec3>& oldPos,
                                const std::vector<glm::ivec3>& newPos);
-    void rebuildMap();
-    void rebuildPositions();
     // void printCenterColors(RubiksCube* cube);
 
     void executeMove(const std::string& move) {
-        if (move == "R")  startRotation('X', 1.0f, 90.0f);
-        else if (move == "R'") startRotation('X', 1.0f, -90.0f);
-        else if (move == "L")  startRotation('X', -1.0f, -90.0f);
-        else if (move == "L'") startRotation('X', -1.0f, 90.0f);
-        else if (move == "U")  startRotation('Y', 1.0f, 90.0f);
-        else if (move == "U'") startRotation('Y', 1.0f, -90.0f);
-        else if (move == "D")  startRotation('Y', -1.0f, -90.0f);
-        else if (move == "D'") startRotation('Y', -1.0f, 90.0f);
-        else if (move == "F")  startRotation('Z', 1.0f, 90.0f);
-        else if (move == "F'") startRotation('Z', 1.0f, -90.0f);
-        else if (move == "B")  startRotation('Z', -1.0f, -90.0f);
-        else if (move == "B'") startRotation('Z', -1.0f, 90.0f);
-        // Middle Layer Movements
-        else if (move == "X") startRotation('X', 0.0f, 90.0f);
-        else if (move == "X'") startRotation('X', 0.0f, -90.0f);
-        else if (move == "Y") startRotation('Y', 0.0f, 90.0f);
-        else if (move == "Y'") startRotation('Y', 0.0f, -90.0f);
-        else if (move == "Z")  startRotation('Z', 0.0f, 90.0f);
-        else if (move == "Z'")  startRotation('Z', 0.0f, -90.0f);
-
-
-
-
+        // Notation (R, L', X, ...) is defined once in CubeState::parseMove
+        char axis;
+        int layer;
+        bool clockwise;
+        if (CubeState::parseMove(move, axis, layer, clockwise)) {
+            startRotation(axis, (float)layer, clockwise ? 90.0f : -90.0f);
+        }
     }
 
 
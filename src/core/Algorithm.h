@@ -0,0 +1,196 @@
+#ifndef CUBECORE_ALGORITHM_H
+#define CUBECORE_ALGORITHM_H
+
+#include "CubieCube.h"
+#include "Move.h"
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// constexpr counterpart of moveFromString: "R", "R2" or "R'"
+constexpr bool parseMoveToken(std::string_view token, Move& m) {
+    constexpr std::string_view FACE_NAMES = "URFDLBXYZ";
+    if (token.empty() || token.size() > 2) return false;
+
+    size_t face = FACE_NAMES.find(token[0]);
+    if (face == std::string_view::npos) return false;
+
+    int power = 1;
+    if (token.size() == 2) {
+        if (token[1] == '2') power = 2;
+        else if (token[1] == '\'') power = 3;
+        else return false;
+    }
+    m = makeMove((int)face, power);
+    return true;
+}
+
+// Calls fn(token) for every space separated token of text
+template <class Fn>
+constexpr void forEachToken(std::string_view text, Fn&& fn) {
+    size_t pos = 0;
+    while (pos < text.size()) {
+        size_t end = text.find(' ', pos);
+        if (end == std::string_view::npos) end = text.size();
+        if (end > pos) fn(text.substr(pos, end - pos));
+        pos = end + 1;
+    }
+}
+
+// Calls fn(move) for every move of a space separated algorithm. An unknown
+// token is an error: a compile error when the algorithm is folded in a
+// constant expression, std::invalid_argument at run time, so a typo like
+// "R U2' F" never folds into another permutation.
+template <class Fn>
+constexpr void forEachMove(std::string_view text, Fn&& fn) {
+    forEachToken(text, [&](std::string_view token) {
+        Move m = U1;
+        if (!parseMoveToken(token, m)) throw std::invalid_argument("unknown move in algorithm");
+        fn(m);
+    });
+}
+
+// Whole-cube rotations x y z as (destination, source) face pairs in U R F D L
+// B order: x brings F up
+inline constexpr int STANDARD_ROTATION_CYCLES[3][4][2] = {
+    {{0, 2}, {2, 3}, {3, 5}, {5, 0}},
+    {{2, 1}, {1, 5}, {5, 4}, {4, 2}},
+    {{1, 0}, {3, 1}, {4, 3}, {0, 4}},
+};
+// Rotation axis and quarter turns that go with each wide turn u r f d l b
+inline constexpr int STANDARD_WIDE_AXIS[6] = {1, 0, 2, 1, 0, 2};
+inline constexpr int STANDARD_WIDE_DIRECTION[6] = {1, 1, 1, 3, 3, 3};
+
+// Calls fn(move) for every face move of an algorithm in standard notation,
+// as cubers write them: R is clockwise seen from R (executeMove's R'),
+// with wide turns (r or Rw), slices M E S and rotations x y z allowed. A
+// wide turn or slice is the opposite face turn(s) plus a whole-cube
+// rotation, and the rotation relabels the faces of every later move. An
+// unknown token, or rotations that do not cancel out by the end, is an
+// error in the same way as for forEachMove.
+template <class Fn>
+constexpr void forEachStandardMove(std::string_view text, Fn&& fn) {
+    constexpr std::string_view FACES = "URFDLB";
+    constexpr std::string_view WIDE = "urfdlb";
+    constexpr std::string_view AXES = "xyz";
+
+    // position[f] is the face currently seen at f
+    int position[6] = {0, 1, 2, 3, 4, 5};
+    auto rotate = [&](int axis, int power) {
+        for (int i = 0; i < power; i++) {
+            int before[6] = {position[0], position[1], position[2], position[3], position[4], position[5]};
+            for (const auto& pair : STANDARD_ROTATION_CYCLES[axis]) position[pair[0]] = before[pair[1]];
+        }
+    };
+    // Standard power 1 (clockwise) is executeMove power 3
+    auto turn = [&](int face, int power) { fn(makeMove(position[face], 4 - power)); };
+
+    forEachToken(text, [&](std::string_view token) {
+        char letter = token[0];
+        size_t i = 1;
+        bool wide = i < token.size() && token[i] == 'w';
+        if (wide) i++;
+        int power = 1;
+        if (i < token.size() && token[i] == '2') {
+            power = 2;
+            i++;
+        }
+        if (i < token.size() && token[i] == '\'') {
+            power = 4 - power;
+            i++;
+        }
+        if (i != token.size()) throw std::invalid_argument("unknown move in algorithm");
+
+        size_t face = FACES.find(letter), wideFace = WIDE.find(letter), axis = AXES.find(letter);
+        if (face != std::string_view::npos && !wide) {
+            turn((int)face, power);
+        } else if (face != std::string_view::npos || wideFace != std::string_view::npos) {
+            // r = L x: the opposite face turns along with the rotation
+            int f = (int)(face != std::string_view::npos ? face : wideFace);
+            turn((f + 3) % 6, power);
+            rotate(STANDARD_WIDE_AXIS[f], STANDARD_WIDE_DIRECTION[f] * power % 4);
+        } else if (wide) {
+            throw std::invalid_argument("unknown move in algorithm");
+        } else if (letter == 'M') {
+            turn(1, power);  // M = R L' x'
+            turn(4, 4 - power);
+            rotate(0, 4 - power);
+        } else if (letter == 'E') {
+            turn(0, power);  // E = U D' y'
+            turn(3, 4 - power);
+            rotate(1, 4 - power);
+        } else if (letter == 'S') {
+            turn(2, 4 - power);  // S = F' B z
+            turn(5, power);
+            rotate(2, power);
+        } else if (axis != std::string_view::npos) {
+            rotate((int)axis, power);
+        } else {
+            throw std::invalid_argument("unknown move in algorithm");
+        }
+    });
+    for (int f = 0; f < 6; f++) {
+        if (position[f] != f) throw std::invalid_argument("algorithm rotates the cube");
+    }
+}
+
+// The whole algorithm as one cubie permutation
+constexpr CubieCube compileAlgorithm(std::string_view text) {
+    CubieCube cube;
+    forEachMove(text, [&](Move m) { cube.applyMove(m); });
+    return cube;
+}
+
+// Likewise for an algorithm in standard notation (see forEachStandardMove)
+constexpr CubieCube compileStandardAlgorithm(std::string_view text) {
+    CubieCube cube;
+    forEachStandardMove(text, [&](Move m) { cube.applyMove(m); });
+    return cube;
+}
+
+constexpr int algorithmLength(std::string_view text) {
+    int length = 0;
+    forEachMove(text, [&](Move) { length++; });
+    return length;
+}
+
+// The text of a fixed algorithm, parsed once to reject unknown moves. Used
+// in a constexpr declaration, e.g.
+//   static constexpr std::string_view SEXY_MOVE = checkedAlgorithm("R U R' U'");
+// a typo is a compile error. For algorithms played on a CubeState, which
+// has no cubie permutation to multiply a folded Algorithm into.
+constexpr std::string_view checkedAlgorithm(std::string_view text) {
+    forEachMove(text, [](Move) {});
+    return text;
+}
+
+// Move strings of an algorithm in executeMove notation
+inline std::vector<std::string> algorithmMoves(std::string_view text) {
+    std::vector<std::string> result;
+    forEachMove(text, [&](Move m) { result.push_back(moveToString(m)); });
+    return result;
+}
+
+// A fixed move sequence folded at compile time. Declared constexpr, e.g.
+//   constexpr Algorithm SEXY_MOVE("R U R' U'");
+// the permutation is a table in the binary, so applying the algorithm to a
+// cubie state is one multiply however many moves it has; cube_bench
+// measures it against move by move. The text is kept for playback through
+// RubiksCube::executeMove. The CFOP tables fold their standard notation
+// algorithms the same way with compileStandardAlgorithm.
+struct Algorithm {
+    std::string_view text;
+    CubieCube cube;
+    int length;
+
+    constexpr explicit Algorithm(std::string_view text)
+        : text(text), cube(compileAlgorithm(text)), length(algorithmLength(text)) {}
+
+    constexpr void applyTo(CubieCube& state) const { state.multiply(cube); }
+
+    // Move strings in executeMove notation
+    std::vector<std::string> moves() const { return algorithmMoves(text); }
+};
+
+#endif // CUBECORE_ALGORITHM_H
@@ -0,0 +1,115 @@
+#include "AnytimeSolver.h"
+#include "CubeAlgebra.h"
+#include "OptimalSolver.h"
+#include "Symmetry.h"
+#include "TwoPhaseSolver.h"
+#include <algorithm>
+
+AnytimeSolver::AnytimeSolver(AnytimeOptions options) : options(options) {}
+
+AnytimeSolver::~AnytimeSolver() { cancel(); }
+
+std::vector<Move> AnytimeSolver::start(const CubieCube& cube) {
+    cancel();
+    startTime = std::chrono::steady_clock::now();
+    cancelled = false;
+    optimal = false;
+
+    std::vector<Move> first = thistlethwaite.solve(cube);
+    if (!solves(cube, first)) first.clear();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        best = first;
+        improved = false;
+        improvedAfterMs = elapsedMs();
+    }
+
+    // Nothing to search for on a solved or unsolvable cube
+    int rotation = centerRotation(cube);
+    CubieCube centered = cube;
+    if (rotation != 0) centered.multiply(symmetryTables().cubes[rotation]);
+    if (!centered.isSolved() && isSolvable(centered)) {
+        searching = true;
+        thread = std::thread(&AnytimeSolver::search, this, cube);
+    }
+    return first;
+}
+
+void AnytimeSolver::cancel() {
+    cancelled = true;
+    if (thread.joinable()) thread.join();
+    searching = false;
+}
+
+bool AnytimeSolver::takeImprovement(std::vector<Move>& solution) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!improved) return false;
+    improved = false;
+    solution = best;
+    return true;
+}
+
+double AnytimeSolver::getImprovedAfterMs() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return improvedAfterMs;
+}
+
+double AnytimeSolver::elapsedMs() const {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+// The cube after solution is solved, up to a whole-cube rotation
+bool AnytimeSolver::solves(CubieCube cube, const std::vector<Move>& solution) {
+    for (Move m : solution) cube.applyMove(m);
+    cube.multiply(symmetryTables().cubes[centerRotation(cube)]);
+    return cube.isSolved();
+}
+
+void AnytimeSolver::publish(const std::vector<Move>& solution) {
+    std::lock_guard<std::mutex> lock(mutex);
+    // Empty when start() had no first solution
+    if (!best.empty() && solution.size() >= best.size()) return;
+    best = solution;
+    improved = true;
+    improvedAfterMs = elapsedMs();
+}
+
+void AnytimeSolver::search(CubieCube cube) {
+    // Two-phase with no target length keeps improving until its time is up
+    TwoPhaseOptions twoPhaseOptions;
+    twoPhaseOptions.targetLength = 0;
+    twoPhaseOptions.timeLimitMs = options.optimal ? std::min(options.twoPhaseMs, options.deadlineMs)
+                                                  : options.deadlineMs;
+    twoPhaseOptions.onImprovement = [this](const std::vector<Move>& solution) { publish(solution); };
+    twoPhaseOptions.cancel = &cancelled;
+    twoPhaseOptions.race = true;
+    TwoPhaseSolver twoPhase(twoPhaseOptions);
+    twoPhase.solve(cube);
+
+    // The first call builds the databases, which cancel() must not wait out
+    if (options.optimal && !cancelled && patternDatabases(&cancelled)) {
+        double remaining = options.deadlineMs - elapsedMs();
+        size_t length;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            length = best.size();
+        }
+        if (remaining > 0 && length > 0) {
+            // Only a shorter solution is of interest; finding none proves the
+            // best one optimal
+            OptimalOptions optimalOptions;
+            optimalOptions.maxDepth = (int)length - 1;
+            optimalOptions.timeLimitMs = remaining;
+            optimalOptions.cancel = &cancelled;
+            OptimalSolver solver(optimalOptions);
+            OptimalResult result = solver.solve(cube);
+            if (result.solved) {
+                publish(result.moves);
+                optimal = true;
+            } else if (!result.stopped && result.lowerBound >= (int)length) {
+                optimal = true;
+            }
+        }
+    }
+    searching = false;
+}
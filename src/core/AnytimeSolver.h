@@ -0,0 +1,82 @@
+#ifndef CUBECORE_ANYTIMESOLVER_H
+#define CUBECORE_ANYTIMESOLVER_H
+
+#include "CubieCube.h"
+#include "Move.h"
+#include "ThistlethwaiteSolver.h"
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// A solution right away, better ones later. start() returns the
+// Thistlethwaite solution (a table walk, microseconds, 30-45 moves) and
+// leaves a background thread searching for shorter ones: two-phase search
+// first (racing all axes and the inverse), whose solutions shrink to around
+// 20 moves within the first second, then optionally Korf's IDA* bounded by
+// the best length so far, which either finds a shorter solution or proves
+// the last one optimal. Every improvement is published as it is found,
+// until the deadline or cancel().
+
+struct AnytimeOptions {
+    double deadlineMs = 3000;  // from start(); the search stops after it
+    double twoPhaseMs = 1000;  // share of the deadline for two-phase when optimal is set
+    // Finish with the optimal solver. Its pattern databases are built on
+    // first use, which takes about a minute of the deadline.
+    bool optimal = false;
+};
+
+class AnytimeSolver {
+public:
+    explicit AnytimeSolver(AnytimeOptions options = {});
+    ~AnytimeSolver();
+
+    AnytimeSolver(const AnytimeSolver&) = delete;
+    AnytimeSolver& operator=(const AnytimeSolver&) = delete;
+
+    // First solution of cube (up to a whole-cube rotation when slice turns
+    // moved the centers), checked to solve it; empty when solved,
+    // unsolvable, or if the check fails, in which case the background
+    // search still runs and its first solution counts as an improvement.
+    // Cancels the search of a previous start().
+    std::vector<Move> start(const CubieCube& cube);
+
+    // Stops the background search and waits for it
+    void cancel();
+    // Asks the background search to stop without waiting; isSearching()
+    // turns false once it has
+    void requestCancel() { cancelled = true; }
+
+    bool isSearching() const { return searching; }
+    // The best solution so far is proven shortest
+    bool isOptimal() const { return optimal; }
+
+    // The best solution so far, if it changed since the last call (or since
+    // start(), which returned the first one)
+    bool takeImprovement(std::vector<Move>& solution);
+
+    // Milliseconds after start() at which the best solution so far was found
+    double getImprovedAfterMs() const;
+
+private:
+    AnytimeOptions options;
+    ThistlethwaiteSolver thistlethwaite;
+    std::thread thread;
+    std::atomic<bool> cancelled{false};
+    std::atomic<bool> searching{false};
+    std::atomic<bool> optimal{false};
+
+    mutable std::mutex mutex;
+    std::vector<Move> best;
+    bool improved = false;
+    double improvedAfterMs = 0;
+    std::chrono::steady_clock::time_point startTime;
+
+    static bool solves(CubieCube cube, const std::vector<Move>& solution);
+    void publish(const std::vector<Move>& solution);
+    void search(CubieCube cube);
+    double elapsedMs() const;
+};
+
+#endif // CUBECORE_ANYTIMESOLVER_H
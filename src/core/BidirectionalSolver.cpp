@@ -0,0 +1,249 @@
+#include "BidirectionalSolver.h"
+#include "Coordinates.h"
+#include "CubeAlgebra.h"
+#include "Symmetry.h"
+#include <algorithm>
+
+static constexpr uint32_t EMPTY_SLOT = 0xffffffff;
+static constexpr int EDGE_BITS = 55;            // 11 edge states of 5 bits
+static constexpr uint64_t EDGE_MASK = (1ull << EDGE_BITS) - 1;
+static constexpr int ROOT_MOVE = 31;            // no move reached the start
+
+static uint64_t encodeEdges(const uint8_t* edges) {
+    uint64_t key = 0;
+    for (int i = 0; i < EDGE_COUNT - 1; i++) key |= (uint64_t)edges[i] << (i * 5);
+    return key;
+}
+
+static void decodeEdges(uint64_t key, uint8_t* edges) {
+    int slots = 0, flips = 0;
+    for (int i = 0; i < EDGE_COUNT - 1; i++) {
+        edges[i] = (key >> (i * 5)) & 31;
+        slots += edges[i] >> 1;
+        flips += edges[i] & 1;
+    }
+    // The slots add up to 0 + 1 + ... + 11 and the flips to an even number
+    edges[EDGE_COUNT - 1] = (66 - slots) * 2 + (flips & 1);
+}
+
+static size_t slotHash(uint32_t corner, uint64_t edgeKey) {
+    uint64_t h = edgeKey ^ (corner * 0x9e3779b97f4a7c15ull);
+    h = (h ^ (h >> 31)) * 0xbf58476d1ce4e5b9ull;
+    return h ^ (h >> 29);
+}
+
+// --- Side ---
+
+size_t BidirectionalSolver::Side::find(const State& s) const {
+    size_t mask = corners.size() - 1;
+    for (size_t i = slotHash(s.corner, s.edges) & mask;; i = (i + 1) & mask) {
+        if (corners[i] == EMPTY_SLOT) return SIZE_MAX;
+        if (corners[i] == s.corner && (edges[i] & EDGE_MASK) == s.edges) return i;
+    }
+}
+
+void BidirectionalSolver::Side::insert(const State& s, int move, int stateDepth) {
+    size_t mask = corners.size() - 1;
+    size_t i = slotHash(s.corner, s.edges) & mask;
+    while (corners[i] != EMPTY_SLOT) i = (i + 1) & mask;
+    corners[i] = s.corner;
+    edges[i] = s.edges | (uint64_t)move << EDGE_BITS | (uint64_t)stateDepth << 60;
+    size++;
+}
+
+// Keeps the table at most half full for the given number of states
+void BidirectionalSolver::Side::reserve(size_t states) {
+    size_t capacity = 1024;
+    while (capacity < states * 2) capacity *= 2;
+    if (capacity <= corners.size()) return;
+
+    std::vector<uint32_t> oldCorners(capacity, EMPTY_SLOT);
+    std::vector<uint64_t> oldEdges(capacity);
+    oldCorners.swap(corners);
+    oldEdges.swap(edges);
+    size_t mask = capacity - 1;
+    for (size_t j = 0; j < oldCorners.size(); j++) {
+        if (oldCorners[j] == EMPTY_SLOT) continue;
+        size_t i = slotHash(oldCorners[j], oldEdges[j] & EDGE_MASK) & mask;
+        while (corners[i] != EMPTY_SLOT) i = (i + 1) & mask;
+        corners[i] = oldCorners[j];
+        edges[i] = oldEdges[j];
+    }
+}
+
+// --- Solver ---
+
+BidirectionalSolver::State BidirectionalSolver::applyMove(const State& s, int m) {
+    const CoordinateTables& t = coordinateTables();
+    uint32_t perm = s.corner / TWIST_COUNT, twist = s.corner % TWIST_COUNT;
+    uint8_t edges[EDGE_COUNT];
+    decodeEdges(s.edges, edges);
+    for (int e = 0; e < EDGE_COUNT - 1; e++) edges[e] = EDGE_STATE_MOVES[edges[e]][m];
+    return {t.cornerPermMove[perm][m] * (uint32_t)TWIST_COUNT + t.twistMove[twist][m], encodeEdges(edges)};
+}
+
+BidirectionalSolver::BidirectionalSolver(BidirectionalOptions options) : options(options) {}
+
+BidirectionalResult BidirectionalSolver::solve(const CubieCube& cube) {
+    startTime = std::chrono::steady_clock::now();
+    result = BidirectionalResult();
+    stopped = false;
+    probePath.clear();
+
+    int rotation = centerRotation(cube);
+    CubieCube start = cube;
+    if (rotation != 0) start.multiply(symmetryTables().cubes[rotation]);
+
+    if (isSolvable(start)) {
+        uint8_t startEdges[EDGE_COUNT], solvedEdges[EDGE_COUNT];
+        for (int i = 0; i < EDGE_COUNT; i++) {
+            startEdges[start.ep[i]] = i * 2 + start.eo[i];
+            solvedEdges[i] = i * 2;
+        }
+
+        Side forward, backward;
+        forward.reserve(1);
+        backward.reserve(1);
+        forward.insert({rankCornerPerm(start) * (uint32_t)TWIST_COUNT + rankTwist(start), encodeEdges(startEdges)},
+                       ROOT_MOVE, 0);
+        backward.insert({0, encodeEdges(solvedEdges)}, ROOT_MOVE, 0);
+
+        meeting = {0, encodeEdges(solvedEdges)};
+        bool met = start.isSolved(), full = false;
+        const Side* prober = nullptr;
+        while (!met && !stopped && forward.depth + backward.depth < options.maxDepth) {
+            result.lowerBound = forward.depth + backward.depth + 1;
+            Side& side = forward.frontier <= backward.frontier ? forward : backward;
+            Side& other = &side == &forward ? backward : forward;
+            if (forward.size + backward.size + side.frontier * 15 > options.maxStates) {
+                full = true;
+                prober = &side;
+                break;
+            }
+            met = expand(side, other);
+        }
+
+        // Out of room: look further from the smaller frontier without storing
+        for (int extra = 1; full && !met && !stopped
+                            && forward.depth + backward.depth + extra <= options.maxDepth; extra++) {
+            result.lowerBound = forward.depth + backward.depth + extra;
+            met = probeLevel(*prober, prober == &forward ? backward : forward, extra);
+        }
+
+        if (met) {
+            // Moves from the start and from the solved cube to the meeting
+            std::vector<Move> fromStart, fromSolved;
+            if (probePath.empty()) {
+                fromStart = pathTo(forward, meeting);
+                fromSolved = pathTo(backward, meeting);
+            } else {
+                const Side& other = prober == &forward ? backward : forward;
+                std::vector<Move>& probed = prober == &forward ? fromStart : fromSolved;
+                probed = pathTo(*prober, probeStart);
+                probed.insert(probed.end(), probePath.begin(), probePath.end());
+                (prober == &forward ? fromSolved : fromStart) = pathTo(other, meeting);
+            }
+            result.solved = true;
+            result.moves = fromStart;
+            for (auto it = fromSolved.rbegin(); it != fromSolved.rend(); ++it) {
+                result.moves.push_back(inverseMove(*it));
+            }
+            result.lowerBound = result.moves.size();
+        }
+        result.states = forward.size + backward.size;
+    }
+
+    if (rotation != 0) {
+        const SymmetryTables& sym = symmetryTables();
+        for (Move& m : result.moves) m = sym.moveConjugate[sym.inverse[rotation]][m];
+    }
+    result.milliseconds = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - startTime).count();
+    return result;
+}
+
+bool BidirectionalSolver::timeUp() {
+    if (options.timeLimitMs > 0 && std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - startTime).count() > options.timeLimitMs) {
+        stopped = true;
+    }
+    return stopped;
+}
+
+// Grows side by one level. Returns true at the first state the other side
+// has reached too; with both balls complete, that meeting is a shortest one.
+bool BidirectionalSolver::expand(Side& side, const Side& other) {
+    side.reserve(side.size + side.frontier * 15);
+
+    // Slots are scanned in place: new states go in one level deeper and the
+    // table does not grow while scanning
+    size_t frontier = 0;
+    for (size_t i = 0; i < side.corners.size(); i++) {
+        if (side.corners[i] == EMPTY_SLOT || (int)(side.edges[i] >> 60) != side.depth) continue;
+        State s{side.corners[i], side.edges[i] & EDGE_MASK};
+        int last = (side.edges[i] >> EDGE_BITS) & 31;
+
+        for (int m = 0; m < FACE_MOVE_COUNT; m++) {
+            // A second turn of the same face reaches a state no deeper than this one
+            if (last != ROOT_MOVE && moveFace(Move(last)) == moveFace(Move(m))) continue;
+
+            State next = applyMove(s, m);
+            if (side.contains(next)) continue;
+            side.insert(next, m, side.depth + 1);
+            frontier++;
+            if (other.contains(next)) {
+                side.depth++;
+                side.frontier = frontier;
+                meeting = next;
+                return true;
+            }
+        }
+        if ((i & 0xfffff) == 0 && timeUp()) return false;
+    }
+    side.depth++;
+    side.frontier = frontier;
+    return false;
+}
+
+// Every sequence of extra moves from each frontier state of side, looked up
+// on the other side. Shorter ones found nothing, so the first hit is again
+// a shortest solution.
+bool BidirectionalSolver::probeLevel(const Side& side, const Side& other, int extra) {
+    for (size_t i = 0; i < side.corners.size() && !stopped; i++) {
+        if (side.corners[i] == EMPTY_SLOT || (int)(side.edges[i] >> 60) != side.depth) continue;
+        probeStart = {side.corners[i], side.edges[i] & EDGE_MASK};
+        if (probe(other, probeStart, (side.edges[i] >> EDGE_BITS) & 31, extra)) return true;
+    }
+    return false;
+}
+
+bool BidirectionalSolver::probe(const Side& other, const State& s, int last, int extra) {
+    if (extra == 0) {
+        if ((++result.probes & 0xfffff) == 0 && timeUp()) return false;
+        if (!other.contains(s)) return false;
+        meeting = s;
+        return true;
+    }
+    for (int m = 0; m < FACE_MOVE_COUNT; m++) {
+        if (last != ROOT_MOVE && moveFace(Move(last)) == moveFace(Move(m))) continue;
+        probePath.push_back(Move(m));
+        if (probe(other, applyMove(s, m), m, extra - 1)) return true;
+        probePath.pop_back();
+        if (stopped) return false;
+    }
+    return false;
+}
+
+// Moves from the side's start to the given state, found by undoing the
+// stored moves back to depth 0
+std::vector<Move> BidirectionalSolver::pathTo(const Side& side, State s) const {
+    std::vector<Move> path;
+    for (;;) {
+        int move = (side.edges[side.find(s)] >> EDGE_BITS) & 31;
+        if (move == ROOT_MOVE) break;
+        path.push_back(Move(move));
+        s = applyMove(s, inverseMove(Move(move)));
+    }
+    std::reverse(path.begin(), path.end());
+    return path;
+}
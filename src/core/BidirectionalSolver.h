@@ -0,0 +1,89 @@
+#ifndef CUBECORE_BIDIRECTIONALSOLVER_H
+#define CUBECORE_BIDIRECTIONALSOLVER_H
+
+#include "CubieCube.h"
+#include "Move.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Meet-in-the-middle: breadth-first search from the scrambled cube and from
+// the solved cube at once, always growing the smaller frontier by one level,
+// until a state turns up on both sides. Both balls are complete up to their
+// depth, so the first meeting is a shortest solution. A position n moves
+// deep costs about two balls of n/2 moves (13^(n/2) states each) instead of
+// 13^n, with no precomputed tables. Once the state budget allows no
+// further level, the levels beyond are only probed: every move sequence of
+// that length from the smaller frontier is looked up on the other side.
+// Positions up to 10 moves take a tenth of a second, 12 moves about 16
+// million states (some 400 MB, a few seconds), 13 moves another level of
+// probes (tens of seconds).
+
+struct BidirectionalOptions {
+    int maxDepth = 14;
+    size_t maxStates = 24000000;  // both sides together, 12 bytes per slot at half load
+    double timeLimitMs = 0;       // 0 for no limit
+};
+
+struct BidirectionalResult {
+    std::vector<Move> moves;
+    bool solved = false;      // false when stopped by a limit
+    int lowerBound = 0;       // proven: no solution is shorter than this
+    long states = 0;          // stored on both sides
+    long probes = 0;          // looked up past the stored levels
+    double milliseconds = 0;
+};
+
+class BidirectionalSolver {
+public:
+    explicit BidirectionalSolver(BidirectionalOptions options = {});
+
+    // Shortest face-turn solution. Centers moved by slice turns are put back
+    // with a whole-cube rotation first, as in TwoPhaseSolver.
+    BidirectionalResult solve(const CubieCube& cube);
+
+private:
+    // A cube as stored: the corner coordinate (permutation * 2187 + twist)
+    // and the slot * 2 + flip of edges 0..10, 5 bits each (edge 11 follows
+    // from them)
+    struct State {
+        uint32_t corner;
+        uint64_t edges;
+    };
+
+    // States reached from one side, in an open-addressing table. The edge
+    // word of a slot also holds the move that reached the state and its depth.
+    struct Side {
+        std::vector<uint32_t> corners;
+        std::vector<uint64_t> edges;
+        size_t size = 0;
+        int depth = 0;
+        size_t frontier = 1;  // states at depth
+
+        bool contains(const State& s) const { return find(s) != SIZE_MAX; }
+        size_t find(const State& s) const;
+        void insert(const State& s, int move, int depth);
+        void reserve(size_t states);
+    };
+
+    BidirectionalOptions options;
+    BidirectionalResult result;
+    bool stopped = false;
+    std::chrono::steady_clock::time_point startTime;
+
+    // Where the two searches met: the state, and for a meeting found by
+    // probing, the stored state the probe started from and its moves
+    State meeting;
+    State probeStart;
+    std::vector<Move> probePath;
+
+    static State applyMove(const State& s, int m);
+    bool expand(Side& side, const Side& other);
+    bool probeLevel(const Side& side, const Side& other, int extra);
+    bool probe(const Side& other, const State& s, int last, int extra);
+    bool timeUp();
+    std::vector<Move> pathTo(const Side& side, State s) const;
+};
+
+#endif // CUBECORE_BIDIRECTIONALSOLVER_H
@@ -0,0 +1,34 @@
+#ifndef CUBECORE_BITS_H
+#define CUBECORE_BITS_H
+
+#include <bitset>
+#include <cstdint>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// Bit counting for the coordinate and table code. The GCC and Clang
+// builtins compile to single instructions; MSVC has neither, and <bit> needs
+// C++20, so it gets its own intrinsic or the std::bitset equivalent.
+
+// Number of set bits
+inline int popcount(uint64_t x) {
+#if defined(_MSC_VER)
+    return (int)std::bitset<64>(x).count();
+#else
+    return __builtin_popcountll(x);
+#endif
+}
+
+// Index of the lowest set bit; x must not be 0
+inline int countTrailingZeros(uint64_t x) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, x);
+    return (int)index;
+#else
+    return __builtin_ctzll(x);
+#endif
+}
+
+#endif // CUBECORE_BITS_H
@@ -0,0 +1,528 @@
+#include "CfopSolver.h"
+#include "Algorithm.h"
+#include "Coordinates.h"
+#include "CubeAlgebra.h"
+#include "PruningTable.h"
+#include "Simplify.h"
+#include "Symmetry.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <memory>
+
+// Last layer algorithms as cubers write them: standard notation (R is
+// clockwise seen from R), with wide turns, slices and rotations allowed (see
+// forEachStandardMove). Each is folded into its permutation at compile
+// time, so a typo is a compile error.
+struct NamedAlgorithm {
+    const char* name;
+    std::string_view moves;
+    CubieCube cube;
+
+    constexpr NamedAlgorithm(const char* name, std::string_view moves)
+        : name(name), moves(moves), cube(compileStandardAlgorithm(moves)) {}
+};
+
+static constexpr NamedAlgorithm OLL_ALGORITHMS[] = {
+    {"OLL 1", "R U2 R2 F R F' U2 R' F R F'"},
+    {"OLL 2", "F R U R' U' F' f R U R' U' f'"},
+    {"OLL 3", "f R U R' U' f' U' F R U R' U' F'"},
+    {"OLL 4", "f R U R' U' f' U F R U R' U' F'"},
+    {"OLL 5", "r' U2 R U R' U r"},
+    {"OLL 6", "r U2 R' U' R U' r'"},
+    {"OLL 7", "r U R' U R U2 r'"},
+    {"OLL 8", "l' U' L U' L' U2 l"},
+    {"OLL 9", "R U R' U' R' F R2 U R' U' F'"},
+    {"OLL 10", "R U R' U R' F R F' R U2 R'"},
+    {"OLL 11", "r U R' U R' F R F' R U2 r'"},
+    {"OLL 12", "M' R' U' R U' R' U2 R U' R r'"},
+    {"OLL 13", "F U R U' R2 F' R U R U' R'"},
+    {"OLL 14", "R' F R U R' F' R F U' F'"},
+    {"OLL 15", "r' U' r R' U' R U r' U r"},
+    {"OLL 16", "r U r' R U R' U' r U' r'"},
+    {"OLL 17", "R U R' U R' F R F' U2 R' F R F'"},
+    {"OLL 18", "r U R' U R U2 r2 U' R U' R' U2 r"},
+    {"OLL 19", "M U R U R' U' M' R' F R F'"},
+    {"OLL 20", "r U R' U' M2 U R U' R' U' M'"},
+    {"OLL 21", "R U2 R' U' R U R' U' R U' R'"},
+    {"OLL 22", "R U2 R2 U' R2 U' R2 U2 R"},
+    {"OLL 23", "R2 D' R U2 R' D R U2 R"},
+    {"OLL 24", "r U R' U' r' F R F'"},
+    {"OLL 25", "F' r U R' U' r' F R"},
+    {"OLL 26", "R U2 R' U' R U' R'"},
+    {"OLL 27", "R U R' U R U2 R'"},
+    {"OLL 28", "r U R' U' r' R U R U' R'"},
+    {"OLL 29", "R U R' U' R U' R' F' U' F R U R'"},
+    {"OLL 30", "F R' F R2 U' R' U' R U R' F2"},
+    {"OLL 31", "R' U' F U R U' R' F' R"},
+    {"OLL 32", "L U F' U' L' U L F L'"},
+    {"OLL 33", "R U R' U' R' F R F'"},
+    {"OLL 34", "R U R2 U' R' F R U R U' F'"},
+    {"OLL 35", "R U2 R2 F R F' R U2 R'"},
+    {"OLL 36", "L' U' L U' L' U L U L F' L' F"},
+    {"OLL 37", "F R' F' R U R U' R'"},
+    {"OLL 38", "R U R' U R U' R' U' R' F R F'"},
+    {"OLL 39", "L F' L' U' L U F U' L'"},
+    {"OLL 40", "R' F R U R' U' F' U R"},
+    {"OLL 41", "R U R' U R U2 R' F R U R' U' F'"},
+    {"OLL 42", "R' U' R U' R' U2 R F R U R' U' F'"},
+    {"OLL 43", "F' U' L' U L F"},
+    {"OLL 44", "F U R U' R' F'"},
+    {"OLL 45", "F R U R' U' F'"},
+    {"OLL 46", "R' U' R' F R F' U R"},
+    {"OLL 47", "F' L' U' L U L' U' L U F"},
+    {"OLL 48", "F R U R' U' R U R' U' F'"},
+    {"OLL 49", "r U' r2 U r2 U r2 U' r"},
+    {"OLL 50", "r' U r2 U' r2 U' r2 U r'"},
+    {"OLL 51", "F U R U' R' U R U' R' F'"},
+    {"OLL 52", "R U R' U R U' B U' B' R'"},
+    {"OLL 53", "l' U2 L U L' U' L U L' U l"},
+    {"OLL 54", "r U2 R' U' R U R' U' R U' r'"},
+    {"OLL 55", "R U2 R2 U' R U' R' U2 F R F'"},
+    {"OLL 56", "r U r' U R U' R' U R U' R' r U' r'"},
+    {"OLL 57", "R U R' U' M' U R U' r'"},
+};
+
+static constexpr NamedAlgorithm PLL_ALGORITHMS[] = {
+    {"PLL Aa", "x R' U R' D2 R U' R' D2 R2 x'"},
+    {"PLL Ab", "x R2 D2 R U R' D2 R U' R x'"},
+    {"PLL E", "x' R U' R' D R U R' D' R U R' D R U' R' D' x"},
+    {"PLL F", "R' U' F' R U R' U' R' F R2 U' R' U' R U R' U R"},
+    {"PLL Ga", "R2 U R' U R' U' R U' R2 U' D R' U R D'"},
+    {"PLL Gb", "R' U' R U D' R2 U R' U R U' R U' R2 D"},
+    {"PLL Gc", "R2 U' R U' R U R' U R2 U D' R U' R' D"},
+    {"PLL Gd", "R U R' U' D R2 U' R U' R' U R' U R2 D'"},
+    {"PLL H", "M2 U M2 U2 M2 U M2"},
+    {"PLL Ja", "x R2 F R F' R U2 r' U r U2 x'"},
+    {"PLL Jb", "R U R' F' R U R' U' R' F R2 U' R'"},
+    {"PLL Na", "R U R' U R U R' F' R U R' U' R' F R2 U' R' U2 R U' R'"},
+    {"PLL Nb", "R' U R U' R' F' U' F R U R' F R' F' R U' R"},
+    {"PLL Ra", "R U' R' U' R U R D R' U' R D' R' U2 R'"},
+    {"PLL Rb", "R2 F R U R U' R' F' R U2 R' U2 R"},
+    {"PLL T", "R U R' U' R' F R2 U' R' U' R U R' F'"},
+    {"PLL Ua", "R U' R U R U R U' R' U' R2"},
+    {"PLL Ub", "R2 U R U R' U' R' U' R' U R'"},
+    {"PLL V", "R U' R U R' D R D' R U' D R2 U R2 D' R2"},
+    {"PLL Y", "F R U' R' U' R U R' F' R U R' U' R' F R F'"},
+    {"PLL Z", "M' U M2 U M2 U M' U2 M2"},
+};
+
+static constexpr int CROSS_EDGE_COUNT = 4;   // DR DF DL DB
+static constexpr int F2L_SLOT_COUNT = 4;     // DFR+FR, DLF+FL, DBL+BL, DRB+BR
+static constexpr const char* F2L_SLOT_NAMES[F2L_SLOT_COUNT] = {"FR", "FL", "BL", "BR"};
+static constexpr int PAIR_STATE_COUNT = 24 * 24;  // (slot * 3 + twist) * 24 + slot * 2 + flip
+static constexpr int OLL_STATE_COUNT = 81 * 16;   // corner twists base 3, edge flips as bits
+static constexpr int PLL_STATE_COUNT = 24 * 24;   // corner order * 24 + edge order
+static constexpr uint8_t NO_OPTION = 0xff;
+static constexpr int LOOK_COST = 32;  // longer than any last layer algorithm
+
+// Move sequences a step may play, and the state each one leads to from
+// every state of the step's coordinate
+struct OptionGraph {
+    int stateCount = 0;
+    std::vector<std::string> names;    // last layer algorithm names
+    std::vector<std::vector<Move>> moves;
+    std::vector<CubieCube> cubes;       // what each option's moves do
+    std::vector<uint16_t> transitions;  // [state * option count + option]
+};
+
+// Cheapest option to play from each state on the way to the goal, and the
+// moves left from there; NO_OPTION at the goal and where it is out of reach
+struct CaseTable {
+    std::vector<uint8_t> next;
+    std::vector<uint8_t> cost;
+};
+
+struct CfopTables {
+    PruningTable cross;
+    // U turns, then X U^k X' for each side turn X that lifts a pair out of
+    // its slot (which pairSlot records; -1 for the U turns)
+    OptionGraph f2l;
+    std::vector<int> pairSlot;
+    // By slot and the mask of unsolved slots, whose triggers may be used
+    CaseTable f2lCases[F2L_SLOT_COUNT][1 << F2L_SLOT_COUNT];
+    OptionGraph oll, pll;
+    CaseTable ollCases, pllCases;
+};
+
+// --- Helpers ---
+
+// Plays one move, merging it into the previous one on the same face
+static void appendFolded(std::vector<Move>& moves, Move m) {
+    if (!moves.empty() && moveFace(moves.back()) == moveFace(m)) {
+        int power = (movePower(moves.back()) + movePower(m)) % 4;
+        moves.pop_back();
+        if (power != 0) moves.push_back(makeMove(moveFace(m), power));
+    } else {
+        moves.push_back(m);
+    }
+}
+
+static uint32_t crossIndex(const CubieCube& c) {
+    uint8_t states[CROSS_EDGE_COUNT];
+    for (int i = 0; i < EDGE_COUNT; i++) {
+        if (c.ep[i] >= DR && c.ep[i] <= DB) states[c.ep[i] - DR] = i * 2 + c.eo[i];
+    }
+    return rankEdgeGroup(states, CROSS_EDGE_COUNT);
+}
+
+static uint32_t crossMove(uint32_t index, int m) {
+    uint8_t states[CROSS_EDGE_COUNT];
+    unrankEdgeGroup(index, states, CROSS_EDGE_COUNT);
+    for (uint8_t& s : states) s = EDGE_STATE_MOVES[s][m];
+    return rankEdgeGroup(states, CROSS_EDGE_COUNT);
+}
+
+static int pairState(const CubieCube& c, int slot) {
+    int corner = 0, edge = 0;
+    while (c.cp[corner] != DFR + slot) corner++;
+    while (c.ep[edge] != FR + slot) edge++;
+    return (corner * 3 + c.co[corner]) * 24 + edge * 2 + c.eo[edge];
+}
+
+static bool isPairSolved(const CubieCube& c, int slot) {
+    return pairState(c, slot) == ((DFR + slot) * 3) * 24 + (FR + slot) * 2;
+}
+
+static int ollState(const CubieCube& c) {
+    int twist = c.co[URF] + 3 * c.co[UFL] + 9 * c.co[ULB] + 27 * c.co[UBR];
+    return twist * 16 + c.eo[UR] + 2 * c.eo[UF] + 4 * c.eo[UL] + 8 * c.eo[UB];
+}
+
+static CubieCube ollCube(int state) {
+    CubieCube c;
+    for (int i = 0, twist = state / 16; i < 4; i++, twist /= 3) c.co[i] = twist % 3;
+    for (int i = 0; i < 4; i++) c.eo[i] = (state >> i) & 1;
+    return c;
+}
+
+static int pllState(const CubieCube& c) {
+    return rankPermutation4(&c.cp[0]) * 24 + rankPermutation4(&c.ep[0]);
+}
+
+static CubieCube pllCube(int state) {
+    CubieCube c;
+    unrankPermutation4(state / 24, &c.cp[0]);
+    unrankPermutation4(state % 24, &c.ep[0]);
+    return c;
+}
+
+// True when the sequence leaves the cross and first two layers in place
+static constexpr bool preservesFirstTwoLayers(const CubieCube& c) {
+    for (int i = DFR; i < CORNER_COUNT; i++) {
+        if (c.cp[i] != i || c.co[i] != 0) return false;
+    }
+    for (int i = DR; i < EDGE_COUNT; i++) {
+        if (c.ep[i] != i || c.eo[i] != 0) return false;
+    }
+    return true;
+}
+
+static constexpr bool preservesLastLayerOrientation(const CubieCube& c) {
+    for (int i = 0; i < 4; i++) {
+        if (c.co[i] != 0 || c.eo[i] != 0) return false;
+    }
+    return true;
+}
+
+// An algorithm that breaks the first two layers (or, for PLL, turns a last
+// layer piece) would solve no case, so the tables are checked when compiled
+template <size_t N>
+static constexpr bool keepsSolvedPieces(const NamedAlgorithm (&algorithms)[N], bool permutes) {
+    for (const NamedAlgorithm& a : algorithms) {
+        if (!preservesFirstTwoLayers(a.cube) || (permutes && !preservesLastLayerOrientation(a.cube))) return false;
+    }
+    return true;
+}
+static_assert(keepsSolvedPieces(OLL_ALGORITHMS, false), "an OLL algorithm moves first two layer pieces");
+static_assert(keepsSolvedPieces(PLL_ALGORITHMS, true), "a PLL algorithm moves F2L pieces or twists the last layer");
+
+// --- Tables ---
+
+template <class StateOf, class CubeOf>
+static void linkOptions(OptionGraph& graph, StateOf stateOf, CubeOf cubeOf) {
+    int optionCount = graph.moves.size();
+    graph.transitions.resize((size_t)graph.stateCount * optionCount);
+    for (int s = 0; s < graph.stateCount; s++) {
+        CubieCube c = cubeOf(s);
+        for (int o = 0; o < optionCount; o++) {
+            graph.transitions[(size_t)s * optionCount + o] = stateOf(compose(c, graph.cubes[o]));
+        }
+    }
+}
+
+// Relaxes until no chain gets cheaper; the graphs have at most 1296 states
+// and every option is a short move sequence, so this settles in a few passes.
+// Each option costs its length plus lookCost, so a large lookCost prefers
+// fewer algorithms over fewer moves.
+static CaseTable chainOptions(const OptionGraph& graph, int goal, const std::vector<bool>& allowed,
+                              int lookCost = 0) {
+    int optionCount = graph.moves.size();
+    CaseTable table;
+    table.next.assign(graph.stateCount, NO_OPTION);
+    table.cost.assign(graph.stateCount, 0xff);
+    table.cost[goal] = 0;
+
+    for (bool changed = true; changed;) {
+        changed = false;
+        for (int s = 0; s < graph.stateCount; s++) {
+            for (int o = 0; o < optionCount; o++) {
+                if (!allowed[o]) continue;
+                int t = graph.transitions[(size_t)s * optionCount + o];
+                int cost = table.cost[t] + (int)graph.moves[o].size() + lookCost;
+                if (table.cost[t] != 0xff && cost < table.cost[s]) {
+                    table.cost[s] = cost;
+                    table.next[s] = o;
+                    changed = true;
+                }
+            }
+        }
+    }
+    return table;
+}
+
+static void addAlgorithms(OptionGraph& graph, const NamedAlgorithm* algorithms, int count) {
+    for (int a = 0; a < count; a++) {
+        const CubieCube& c = algorithms[a].cube;
+        // Each U turn in front gives the case in another orientation
+        for (int u = 0; u < 4; u++) {
+            std::vector<Move> withTurn;
+            CubieCube turned;
+            if (u != 0) {
+                withTurn.push_back(makeMove(0, u));
+                turned = MOVE_CUBES[makeMove(0, u)];
+            }
+            forEachStandardMove(algorithms[a].moves, [&](Move m) { appendFolded(withTurn, m); });
+            graph.names.push_back(algorithms[a].name);
+            graph.moves.push_back(withTurn);
+            graph.cubes.push_back(compose(turned, c));
+        }
+    }
+}
+
+static void buildCross(CfopTables& t) {
+    uint8_t solved[CROSS_EDGE_COUNT];
+    for (int i = 0; i < CROSS_EDGE_COUNT; i++) solved[i] = (DR + i) * 2;
+    t.cross = PruningTable(edgeGroupCount(CROSS_EDGE_COUNT));
+    t.cross.generate(rankEdgeGroup(solved, CROSS_EDGE_COUNT), FACE_MOVE_COUNT,
+                     [](size_t index, int m) { return crossMove(index, m); });
+}
+
+static void buildF2L(CfopTables& t) {
+    OptionGraph& graph = t.f2l;
+    graph.stateCount = PAIR_STATE_COUNT;
+    for (int u = 1; u <= 3; u++) {
+        graph.moves.push_back({makeMove(0, u)});
+        graph.cubes.push_back(MOVE_CUBES[makeMove(0, u)]);
+        t.pairSlot.push_back(-1);
+    }
+
+    // A side turn lifts a slot when X U X' only touches that slot and the U layer
+    for (int slot = 0; slot < F2L_SLOT_COUNT; slot++) {
+        for (int face : {1, 2, 4, 5}) {
+            for (int power : {1, 3}) {
+                Move lift = makeMove(face, power);
+                CubieCube c = sequenceCube({lift, U1, inverseMove(lift)});
+                bool others = true;
+                for (int other = 0; other < F2L_SLOT_COUNT; other++) {
+                    if (other == slot) continue;
+                    others = others && c.cp[DFR + other] == DFR + other && c.co[DFR + other] == 0
+                          && c.ep[FR + other] == FR + other && c.eo[FR + other] == 0;
+                }
+                for (int e = DR; e <= DB; e++) others = others && c.ep[e] == e && c.eo[e] == 0;
+                if (!others || c.ep[FR + slot] == FR + slot) continue;
+
+                for (int u = 1; u <= 3; u++) {
+                    graph.moves.push_back({lift, makeMove(0, u), inverseMove(lift)});
+                    graph.cubes.push_back(sequenceCube(graph.moves.back()));
+                    t.pairSlot.push_back(slot);
+                }
+            }
+        }
+    }
+
+    // Only the pair's own two pieces matter, so act on a cube holding just them
+    linkOptions(graph, [](const CubieCube& c) {
+        int corner = 0, edge = 0;
+        while (c.cp[corner] != DFR) corner++;
+        while (c.ep[edge] != FR) edge++;
+        return (corner * 3 + c.co[corner]) * 24 + edge * 2 + c.eo[edge];
+    }, [](int state) {
+        CubieCube c;
+        int corner = state / 24, edge = state % 24;
+        std::swap(c.cp[DFR], c.cp[corner / 3]);
+        c.co[corner / 3] = corner % 3;
+        std::swap(c.ep[FR], c.ep[edge / 2]);
+        c.eo[edge / 2] = edge % 2;
+        return c;
+    });
+
+    // The state above tracks pieces DFR and FR; other slots' pairs are the
+    // same state space with their own goal
+    for (int slot = 0; slot < F2L_SLOT_COUNT; slot++) {
+        for (int mask = 0; mask < (1 << F2L_SLOT_COUNT); mask++) {
+            if (!(mask & (1 << slot))) continue;
+            std::vector<bool> allowed;
+            for (int s : t.pairSlot) allowed.push_back(s < 0 || (mask & (1 << s)));
+            t.f2lCases[slot][mask] = chainOptions(graph, ((DFR + slot) * 3) * 24 + (FR + slot) * 2, allowed);
+        }
+    }
+}
+
+static void buildLastLayer(CfopTables& t) {
+    t.oll.stateCount = OLL_STATE_COUNT;
+    addAlgorithms(t.oll, OLL_ALGORITHMS, sizeof(OLL_ALGORITHMS) / sizeof(OLL_ALGORITHMS[0]));
+    linkOptions(t.oll, ollState, ollCube);
+    // One algorithm per look when the table has it, as a cuber would
+    t.ollCases = chainOptions(t.oll, 0, std::vector<bool>(t.oll.moves.size(), true), LOOK_COST);
+
+    t.pll.stateCount = PLL_STATE_COUNT;
+    addAlgorithms(t.pll, PLL_ALGORITHMS, sizeof(PLL_ALGORITHMS) / sizeof(PLL_ALGORITHMS[0]));
+    for (int u = 1; u <= 3; u++) {
+        t.pll.names.push_back("AUF");
+        t.pll.moves.push_back({makeMove(0, u)});
+        t.pll.cubes.push_back(MOVE_CUBES[makeMove(0, u)]);
+    }
+    linkOptions(t.pll, pllState, pllCube);
+    t.pllCases = chainOptions(t.pll, 0, std::vector<bool>(t.pll.moves.size(), true), LOOK_COST);
+}
+
+static std::unique_ptr<CfopTables> buildTables() {
+    auto t = std::make_unique<CfopTables>();
+    buildCross(*t);
+    buildF2L(*t);
+    buildLastLayer(*t);
+    return t;
+}
+
+const CfopTables& cfopTables() {
+    static const std::unique_ptr<CfopTables> tables = buildTables();
+    return *tables;
+}
+
+size_t cfopTableBytes() {
+    const CfopTables& t = cfopTables();
+    size_t bytes = t.cross.bytes();
+    for (const auto& bySlot : t.f2lCases) {
+        for (const CaseTable& cases : bySlot) bytes += cases.next.size() + cases.cost.size();
+    }
+    bytes += t.ollCases.next.size() + t.ollCases.cost.size();
+    bytes += t.pllCases.next.size() + t.pllCases.cost.size();
+    return bytes;
+}
+
+CfopLookCounts cfopLastLayerLooks() {
+    const CfopTables& t = cfopTables();
+    CfopLookCounts counts;
+    auto count = [](const OptionGraph& graph, const CaseTable& cases, int& states, int& looks) {
+        size_t optionCount = graph.moves.size();
+        for (int s = 0; s < graph.stateCount; s++) {
+            if (cases.cost[s] == 0xff) continue;
+            states++;
+            int algorithms = 0;
+            for (int at = s; cases.next[at] != NO_OPTION;) {
+                int o = cases.next[at];
+                if (graph.names[o] != "AUF") algorithms++;
+                at = graph.transitions[at * optionCount + o];
+            }
+            looks = std::max(looks, algorithms);
+        }
+    };
+    count(t.oll, t.ollCases, counts.ollStates, counts.ollLooks);
+    count(t.pll, t.pllCases, counts.pllStates, counts.pllLooks);
+    return counts;
+}
+
+// --- Solver ---
+
+CfopSolver::CfopSolver() : tables(cfopTables()) {}
+
+std::vector<Move> CfopSolver::solve(const CubieCube& cube) {
+    auto startTime = std::chrono::steady_clock::now();
+    const CfopTables& t = tables;
+    steps.clear();
+
+    int rotation = centerRotation(cube);
+    CubieCube c = cube;
+    if (rotation != 0) c.multiply(symmetryTables().cubes[rotation]);
+
+    auto play = [&](const std::string& name, const std::vector<Move>& moves) {
+        for (Move m : moves) c.applyMove(m);
+        if (!steps.empty() && steps.back().name == name) {
+            for (Move m : moves) appendFolded(steps.back().moves, m);
+        } else {
+            steps.push_back({name, {}});
+            for (Move m : moves) appendFolded(steps.back().moves, m);
+        }
+    };
+    // Walks a case table from the current state, one option per step
+    auto walk = [&](const OptionGraph& graph, const CaseTable& cases, int (*stateOf)(const CubieCube&)) {
+        for (int s = stateOf(c); cases.next[s] != NO_OPTION; s = stateOf(c)) {
+            play(graph.names[cases.next[s]], graph.moves[cases.next[s]]);
+        }
+        return stateOf(c) == 0;
+    };
+
+    bool solved = isSolvable(c);
+    if (solved) {
+        // Cross: every move one closer, straight down the distance table
+        std::vector<Move> cross;
+        for (uint32_t index = crossIndex(c); t.cross.get(index) != 0;) {
+            int depth = t.cross.get(index);
+            for (int m = 0; m < FACE_MOVE_COUNT; m++) {
+                uint32_t next = crossMove(index, m);
+                if (t.cross.get(next) == depth - 1) {
+                    cross.push_back(Move(m));
+                    index = next;
+                    break;
+                }
+            }
+        }
+        if (!cross.empty()) play("cross", cross);
+
+        // F2L: the pair with the cheapest entry first, until all are in
+        for (;;) {
+            int mask = 0;
+            for (int slot = 0; slot < F2L_SLOT_COUNT; slot++) {
+                if (!isPairSolved(c, slot)) mask |= 1 << slot;
+            }
+            if (mask == 0) break;
+
+            int best = -1, bestCost = 0xff;
+            for (int slot = 0; slot < F2L_SLOT_COUNT; slot++) {
+                if (!(mask & (1 << slot))) continue;
+                int cost = t.f2lCases[slot][mask].cost[pairState(c, slot)];
+                if (cost < bestCost) {
+                    best = slot;
+                    bestCost = cost;
+                }
+            }
+            if (best < 0) {
+                solved = false;
+                break;
+            }
+            const CaseTable& cases = t.f2lCases[best][mask];
+            std::string name = std::string("F2L ") + F2L_SLOT_NAMES[best];
+            for (int s = pairState(c, best); cases.next[s] != NO_OPTION; s = pairState(c, best)) {
+                play(name, t.f2l.moves[cases.next[s]]);
+            }
+        }
+
+        solved = solved && walk(t.oll, t.ollCases, ollState) && walk(t.pll, t.pllCases, pllState);
+    }
+
+    std::vector<Move> solution;
+    if (!solved) steps.clear();
+    if (rotation != 0) {
+        const SymmetryTables& sym = symmetryTables();
+        for (CfopStep& step : steps) {
+            for (Move& m : step.moves) m = sym.moveConjugate[sym.inverse[rotation]][m];
+        }
+    }
+    for (const CfopStep& step : steps) solution.insert(solution.end(), step.moves.begin(), step.moves.end());
+    // Face turns only, like the steps: no opposite face pair becomes a slice
+    solution = simplifyMoves(solution);
+
+    microseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - startTime).count();
+    return solution;
+}
@@ -0,0 +1,64 @@
+#ifndef CUBECORE_CFOPSOLVER_H
+#define CUBECORE_CFOPSOLVER_H
+
+#include "CubieCube.h"
+#include "Move.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// CFOP, the way a speedcuber solves: cross on D, the four corner-edge pairs
+// of the first two layers, then the last layer in two looks (orient, then
+// permute). Every step is a table lookup, so the cost of a solve is bounded
+// and nothing is retried:
+//   cross  exact distance over the 190080 states of the four D edges
+//   F2L    best trigger per pair state (the 41 cases in every U position,
+//          plus pieces stuck in other unsolved slots)
+//   OLL    the 57 algorithms, indexed by last layer orientation
+//   PLL    the 21 algorithms plus the final U turn, indexed by permutation
+// Solutions are typically 50-70 moves.
+
+// Cross distances, F2L trigger tables and the OLL/PLL case tables, about
+// 130 KB together, built on first use
+struct CfopTables;
+const CfopTables& cfopTables();
+size_t cfopTableBytes();
+
+// Last layer states a solve can reach (those whose pieces' twists, flips
+// and parities add up) and the most algorithms any of them takes, the final
+// U turn aside. With an algorithm for every case that is 216 OLL and 288 PLL
+// states at one look each.
+struct CfopLookCounts {
+    int ollStates = 0;
+    int ollLooks = 0;
+    int pllStates = 0;
+    int pllLooks = 0;
+};
+CfopLookCounts cfopLastLayerLooks();
+
+// One step of a solution: "cross", "F2L FR", "OLL 27", "PLL T", "AUF"
+struct CfopStep {
+    std::string name;
+    std::vector<Move> moves;
+};
+
+class CfopSolver {
+public:
+    CfopSolver();
+
+    // Face moves that solve the cube (up to a whole-cube rotation when slice
+    // turns moved the centers); empty when solved or unsolvable
+    std::vector<Move> solve(const CubieCube& cube);
+
+    // Steps of the last solve; solve() joins them and simplifies the turns
+    // that meet at a step boundary (see simplifyMoves)
+    const std::vector<CfopStep>& getSteps() const { return steps; }
+    double getMicroseconds() const { return microseconds; }
+
+private:
+    const CfopTables& tables;
+    std::vector<CfopStep> steps;
+    double microseconds = 0;
+};
+
+#endif // CUBECORE_CFOPSOLVER_H
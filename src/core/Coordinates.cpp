@@ -0,0 +1,233 @@
+#include "Coordinates.h"
+#include "Bits.h"
+#include <memory>
+
+// --- Helpers ---
+
+static constexpr int binomial(int n, int k) {
+    if (k < 0 || k > n) return 0;
+    int result = 1;
+    for (int i = 0; i < k; i++) result = result * (n - i) / (i + 1);
+    return result;
+}
+
+// Lehmer code of a permutation of 0..n-1, 0 for the identity
+static int rankPermutation(const uint8_t* p, int n) {
+    int rank = 0;
+    for (int i = 0; i < n; i++) {
+        int smaller = 0;
+        for (int j = i + 1; j < n; j++) {
+            if (p[j] < p[i]) smaller++;
+        }
+        rank = rank * (n - i) + smaller;
+    }
+    return rank;
+}
+
+static void unrankPermutation(int rank, uint8_t* p, int n) {
+    uint8_t digits[12];
+    for (int i = n - 1; i >= 0; i--) {
+        digits[i] = rank % (n - i);
+        rank /= (n - i);
+    }
+    uint8_t available[12];
+    for (int i = 0; i < n; i++) available[i] = i;
+    for (int i = 0; i < n; i++) {
+        p[i] = available[digits[i]];
+        for (int k = digits[i]; k < n - 1 - i; k++) available[k] = available[k + 1];
+    }
+}
+
+static bool isSliceEdge(uint8_t edge) { return edge >= FR; }
+
+// --- Orientation ---
+
+uint16_t rankTwist(const CubieCube& c) {
+    int twist = 0;
+    for (int i = 0; i < CORNER_COUNT - 1; i++) twist = twist * 3 + c.co[i];
+    return twist;
+}
+
+void unrankTwist(CubieCube& c, uint16_t twist) {
+    int sum = 0;
+    for (int i = CORNER_COUNT - 2; i >= 0; i--) {
+        c.co[i] = twist % 3;
+        sum += c.co[i];
+        twist /= 3;
+    }
+    c.co[CORNER_COUNT - 1] = (3 - sum % 3) % 3;
+}
+
+uint16_t rankFlip(const CubieCube& c) {
+    int flip = 0;
+    for (int i = 0; i < EDGE_COUNT - 1; i++) flip = flip * 2 + c.eo[i];
+    return flip;
+}
+
+void unrankFlip(CubieCube& c, uint16_t flip) {
+    int sum = 0;
+    for (int i = EDGE_COUNT - 2; i >= 0; i--) {
+        c.eo[i] = flip % 2;
+        sum += c.eo[i];
+        flip /= 2;
+    }
+    c.eo[EDGE_COUNT - 1] = sum % 2;
+}
+
+// --- UD slice ---
+
+uint16_t rankSlice(const CubieCube& c) {
+    int slice = 0, found = 0;
+    for (int j = EDGE_COUNT - 1; j >= 0; j--) {
+        if (isSliceEdge(c.ep[j])) {
+            slice += binomial(EDGE_COUNT - 1 - j, found + 1);
+            found++;
+        }
+    }
+    return slice;
+}
+
+void unrankSlice(CubieCube& c, uint16_t slice) {
+    // Slice edges go to the chosen slots in order, the others fill the rest
+    bool chosen[EDGE_COUNT] = {};
+    int found = 4;
+    for (int j = 0; j < EDGE_COUNT; j++) {
+        int weight = binomial(EDGE_COUNT - 1 - j, found);
+        if (found > 0 && slice >= weight) {
+            slice -= weight;
+            chosen[j] = true;
+            found--;
+        }
+    }
+    uint8_t nextSlice = FR, nextOther = UR;
+    for (int j = 0; j < EDGE_COUNT; j++) {
+        c.ep[j] = chosen[j] ? nextSlice++ : nextOther++;
+    }
+}
+
+uint16_t rankSliceSorted(const CubieCube& c) {
+    uint8_t order[4];
+    int found = 0;
+    for (int j = 0; j < EDGE_COUNT; j++) {
+        if (isSliceEdge(c.ep[j])) order[found++] = c.ep[j] - FR;
+    }
+    return rankSlice(c) * SLICE_PERM_COUNT + rankPermutation(order, 4);
+}
+
+void unrankSliceSorted(CubieCube& c, uint16_t sliceSorted) {
+    unrankSlice(c, sliceSorted / SLICE_PERM_COUNT);
+    uint8_t order[4];
+    unrankPermutation(sliceSorted % SLICE_PERM_COUNT, order, 4);
+    int found = 0;
+    for (int j = 0; j < EDGE_COUNT; j++) {
+        if (isSliceEdge(c.ep[j])) c.ep[j] = FR + order[found++];
+    }
+}
+
+// --- Permutations ---
+
+uint16_t rankCornerPerm(const CubieCube& c) {
+    return rankPermutation(c.cp.data(), CORNER_COUNT);
+}
+
+void unrankCornerPerm(CubieCube& c, uint16_t perm) {
+    unrankPermutation(perm, c.cp.data(), CORNER_COUNT);
+}
+
+uint16_t rankUDEdgePerm(const CubieCube& c) {
+    return rankPermutation(c.ep.data(), 8);
+}
+
+void unrankUDEdgePerm(CubieCube& c, uint16_t perm) {
+    unrankPermutation(perm, c.ep.data(), 8);
+}
+
+uint16_t rankSlicePerm(const CubieCube& c) {
+    uint8_t order[4];
+    for (int i = 0; i < 4; i++) order[i] = c.ep[FR + i] - FR;
+    return rankPermutation4(order);
+}
+
+void unrankSlicePerm(CubieCube& c, uint16_t perm) {
+    uint8_t order[4];
+    unrankPermutation4(perm, order);
+    for (int i = 0; i < 4; i++) c.ep[FR + i] = FR + order[i];
+}
+
+int rankPermutation4(const uint8_t* p) {
+    return rankPermutation(p, 4);
+}
+
+void unrankPermutation4(int rank, uint8_t* p) {
+    unrankPermutation(rank, p, 4);
+}
+
+// --- Edge groups ---
+
+uint64_t rankEdgeGroup(const uint8_t* states, int n) {
+    uint64_t placement = 0, flips = 0;
+    unsigned used = 0;
+    for (int i = 0; i < n; i++) {
+        int slot = states[i] >> 1;
+        int digit = slot - popcount(used & ((1u << slot) - 1));
+        placement = placement * (EDGE_COUNT - i) + digit;
+        used |= 1u << slot;
+        flips = flips * 2 + (states[i] & 1);
+    }
+    return (placement << n) + flips;
+}
+
+void unrankEdgeGroup(uint64_t index, uint8_t* states, int n) {
+    uint64_t flips = index & ((1u << n) - 1), placement = index >> n;
+    int digits[EDGE_COUNT];
+    for (int i = n - 1; i >= 0; i--) {
+        digits[i] = placement % (EDGE_COUNT - i);
+        placement /= EDGE_COUNT - i;
+    }
+    unsigned used = 0;
+    for (int i = 0; i < n; i++) {
+        // The digits[i]-th slot not taken yet
+        int slot = 0;
+        for (int free = digits[i]; ; slot++) {
+            if (used & (1u << slot)) continue;
+            if (free-- == 0) break;
+        }
+        used |= 1u << slot;
+        states[i] = slot * 2 + ((flips >> (n - 1 - i)) & 1);
+    }
+}
+
+// --- Move tables ---
+
+// table[x][k] = rank(unrank(x) * moves[k]) for every coordinate value x
+template <int COUNT, int MOVES, class Unrank, class Rank>
+static void buildMoveTable(uint16_t (&table)[COUNT][MOVES], const Move* moves, Unrank unrank, Rank rank) {
+    for (int x = 0; x < COUNT; x++) {
+        CubieCube c;
+        unrank(c, x);
+        for (int k = 0; k < MOVES; k++) {
+            CubieCube moved = c;
+            moved.applyMove(moves[k]);
+            table[x][k] = rank(moved);
+        }
+    }
+}
+
+static std::unique_ptr<CoordinateTables> buildCoordinateTables() {
+    auto tables = std::make_unique<CoordinateTables>();
+    Move faceMoves[FACE_MOVE_COUNT];
+    for (int m = 0; m < FACE_MOVE_COUNT; m++) faceMoves[m] = Move(m);
+
+    buildMoveTable(tables->twistMove, faceMoves, unrankTwist, rankTwist);
+    buildMoveTable(tables->flipMove, faceMoves, unrankFlip, rankFlip);
+    buildMoveTable(tables->sliceSortedMove, faceMoves, unrankSliceSorted, rankSliceSorted);
+    buildMoveTable(tables->cornerPermMove, faceMoves, unrankCornerPerm, rankCornerPerm);
+    buildMoveTable(tables->udEdgePermMove, PHASE2_MOVES, unrankUDEdgePerm, rankUDEdgePerm);
+    buildMoveTable(tables->slicePermMove, PHASE2_MOVES, unrankSlicePerm, rankSlicePerm);
+    return tables;
+}
+
+const CoordinateTables& coordinateTables() {
+    static const std::unique_ptr<CoordinateTables> tables = buildCoordinateTables();
+    return *tables;
+}
@@ -0,0 +1,111 @@
+#ifndef CUBECORE_COORDINATES_H
+#define CUBECORE_COORDINATES_H
+
+#include "CubieCube.h"
+#include "Move.h"
+#include <array>
+#include <cstdint>
+
+// Kociemba-style coordinates: each one ranks a single aspect of a CubieCube
+// to a dense integer, so a search can track the aspect with one table
+// lookup per move instead of permuting pieces. unrank* overwrites only the
+// fields the coordinate describes.
+//
+// The UD-slice edges are FR, FL, BL and BR (ep values 8..11). The phase 2
+// coordinates assume the cube is in the subgroup <U, D, R2, F2, L2, B2>, i.e.
+// the slice edges are in the slice and nothing is twisted or flipped.
+
+constexpr int TWIST_COUNT = 2187;          // 3^7 corner orientations
+constexpr int FLIP_COUNT = 2048;           // 2^11 edge orientations
+constexpr int SLICE_COUNT = 495;           // C(12,4) slice edge positions
+constexpr int SLICE_SORTED_COUNT = 11880;  // slice positions and order, 495 * 24
+constexpr int CORNER_PERM_COUNT = 40320;   // 8!
+constexpr int UD_EDGE_PERM_COUNT = 40320;  // 8! arrangements of the U/D edges (phase 2)
+constexpr int SLICE_PERM_COUNT = 24;       // 4! slice edge order (phase 2)
+
+constexpr int PHASE2_MOVE_COUNT = 10;
+// Moves that keep a cube in the phase 2 subgroup
+constexpr Move PHASE2_MOVES[PHASE2_MOVE_COUNT] = {U1, U2, U3, D1, D2, D3, R2, F2, L2, B2};
+
+uint16_t rankTwist(const CubieCube& c);
+void unrankTwist(CubieCube& c, uint16_t twist);
+
+uint16_t rankFlip(const CubieCube& c);
+void unrankFlip(CubieCube& c, uint16_t flip);
+
+// Which 4 of the 12 edge slots hold slice edges; 0 when they are in the slice
+uint16_t rankSlice(const CubieCube& c);
+void unrankSlice(CubieCube& c, uint16_t slice);
+
+// rankSlice and the order of the slice edges; 0 when solved
+uint16_t rankSliceSorted(const CubieCube& c);
+void unrankSliceSorted(CubieCube& c, uint16_t sliceSorted);
+
+uint16_t rankCornerPerm(const CubieCube& c);
+void unrankCornerPerm(CubieCube& c, uint16_t perm);
+
+// Phase 2 only: order of the 8 U/D edges in slots UR..DB
+uint16_t rankUDEdgePerm(const CubieCube& c);
+void unrankUDEdgePerm(CubieCube& c, uint16_t perm);
+
+// Phase 2 only: order of the slice edges in slots FR..BR
+uint16_t rankSlicePerm(const CubieCube& c);
+void unrankSlicePerm(CubieCube& c, uint16_t perm);
+
+// Lehmer rank of an order of four pieces (values 0..3), 0 for the identity:
+// the slice orders above and the last layer orders of CFOP and
+// Thistlethwaite. unrankPermutation4 writes p[0..3].
+int rankPermutation4(const uint8_t* p);
+void unrankPermutation4(int rank, uint8_t* p);
+
+// Edge groups: a chosen set of n edges, each tracked as slot * 2 + flip (an
+// "edge state"). The group coordinate ranks the slots as a partial
+// permutation, 12 * 11 * ... * (13 - n) values, times the n flip bits.
+// Eight edges or more take more than 32 bits.
+constexpr int EDGE_STATE_COUNT = EDGE_COUNT * 2;
+
+constexpr uint64_t edgeGroupCount(int n) {
+    uint64_t count = 1ull << n;
+    for (int i = 0; i < n; i++) count *= EDGE_COUNT - i;
+    return count;
+}
+
+uint64_t rankEdgeGroup(const uint8_t* states, int n);
+void unrankEdgeGroup(uint64_t index, uint8_t* states, int n);
+
+constexpr std::array<std::array<uint8_t, FACE_MOVE_COUNT>, EDGE_STATE_COUNT> makeEdgeStateMoves() {
+    std::array<std::array<uint8_t, FACE_MOVE_COUNT>, EDGE_STATE_COUNT> table{};
+    for (int m = 0; m < FACE_MOVE_COUNT; m++) {
+        for (int i = 0; i < EDGE_COUNT; i++) {
+            // The edge in slot ep[i] goes to slot i
+            for (int flip = 0; flip < 2; flip++) {
+                table[MOVE_CUBES[m].ep[i] * 2 + flip][m] = i * 2 + (flip ^ MOVE_CUBES[m].eo[i]);
+            }
+        }
+    }
+    return table;
+}
+
+// Edge state after each face move
+inline constexpr std::array<std::array<uint8_t, FACE_MOVE_COUNT>, EDGE_STATE_COUNT> EDGE_STATE_MOVES =
+    makeEdgeStateMoves();
+
+// Coordinate move tables: table[coordinate][move] is the coordinate after
+// the move. Phase 1 tables cover the 18 face moves, the phase 2 ones are
+// indexed by position in PHASE2_MOVES.
+struct CoordinateTables {
+    uint16_t twistMove[TWIST_COUNT][FACE_MOVE_COUNT];
+    uint16_t flipMove[FLIP_COUNT][FACE_MOVE_COUNT];
+    uint16_t sliceSortedMove[SLICE_SORTED_COUNT][FACE_MOVE_COUNT];
+    uint16_t cornerPermMove[CORNER_PERM_COUNT][FACE_MOVE_COUNT];
+    uint16_t udEdgePermMove[UD_EDGE_PERM_COUNT][PHASE2_MOVE_COUNT];
+    uint16_t slicePermMove[SLICE_PERM_COUNT][PHASE2_MOVE_COUNT];
+
+    // The slice coordinate is sliceSorted / 24
+    uint16_t sliceMove(uint16_t slice, Move m) const { return sliceSortedMove[slice * 24][m] / 24; }
+};
+
+// Built on first use (about 2.7 MB, under a tenth of a second), then shared
+const CoordinateTables& coordinateTables();
+
+#endif // CUBECORE_COORDINATES_H
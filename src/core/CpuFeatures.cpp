@@ -0,0 +1,37 @@
+#include "CpuFeatures.h"
+#include <cstdlib>
+#include <cstring>
+
+static CpuLevel detectLevel() {
+#if defined(CUBECORE_X86_KERNELS) && !defined(_MSC_VER)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512vbmi")) return CPU_AVX512VBMI;
+    if (__builtin_cpu_supports("avx2")) return CPU_AVX2;
+    if (__builtin_cpu_supports("ssse3")) return CPU_SSSE3;
+#elif defined(CUBECORE_X86_KERNELS)
+    // MSVC: only what /arch promises
+#if defined(__AVX512VBMI__)
+    return CPU_AVX512VBMI;
+#elif defined(__AVX2__)
+    return CPU_AVX2;
+#endif
+#endif
+    return CPU_SCALAR;
+}
+
+static CpuLevel requestedLevel() {
+    const char* name = std::getenv("CUBECORE_KERNEL");
+    if (!name) return CPU_AVX512VBMI;
+    if (std::strcmp(name, "scalar") == 0) return CPU_SCALAR;
+    if (std::strcmp(name, "ssse3") == 0) return CPU_SSSE3;
+    if (std::strcmp(name, "avx2") == 0) return CPU_AVX2;
+    return CPU_AVX512VBMI;
+}
+
+CpuLevel cpuLevel() {
+    static const CpuLevel level = [] {
+        CpuLevel detected = detectLevel(), requested = requestedLevel();
+        return requested < detected ? requested : detected;
+    }();
+    return level;
+}
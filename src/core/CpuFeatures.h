@@ -0,0 +1,30 @@
+#ifndef CUBECORE_CPUFEATURES_H
+#define CUBECORE_CPUFEATURES_H
+
+// The x86 vector kernels are compiled for their instruction set function by
+// function, with CUBECORE_TARGET, rather than for the whole build, so a
+// default build carries them all and picks one at run time with cpuLevel().
+// MSVC has no target attribute but accepts the intrinsics anyway; it has no
+// __builtin_cpu_supports either, so there the kernels go as far as /arch
+// allows. Other targets get the scalar code.
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define CUBECORE_X86_KERNELS 1
+#define CUBECORE_TARGET(isa) __attribute__((target(isa)))
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#define CUBECORE_X86_KERNELS 1
+#define CUBECORE_TARGET(isa)
+#endif
+
+#if defined(CUBECORE_X86_KERNELS)
+#include <immintrin.h>
+#endif
+
+// Instruction sets the kernels are written for, in increasing order
+enum CpuLevel { CPU_SCALAR, CPU_SSSE3, CPU_AVX2, CPU_AVX512VBMI };
+
+// The highest level this CPU runs, lowered by the CUBECORE_KERNEL
+// environment variable ("scalar", "ssse3", "avx2"), which the tests use to
+// check every kernel on one machine. Read once.
+CpuLevel cpuLevel();
+
+#endif // CUBECORE_CPUFEATURES_H
@@ -0,0 +1,100 @@
+#include "CubeAlgebra.h"
+#include <numeric>
+
+static const char* const CORNER_NAMES[CORNER_COUNT] = {"URF", "UFL", "ULB", "UBR", "DFR", "DLF", "DBL", "DRB"};
+static const char* const EDGE_NAMES[EDGE_COUNT] = {"UR", "UF", "UL", "UB", "DR", "DF",
+                                                   "DL", "DB", "FR", "FL", "BL", "BR"};
+static const char* const CENTER_NAMES[CENTER_COUNT] = {"U", "R", "F", "D", "L", "B"};
+
+// Cycles of one piece kind. perm[i] is the piece in slot i, so the piece
+// leaving slot j lands in the slot i with perm[i] == j.
+template <size_t N>
+static void addCycles(PieceKind kind, const std::array<uint8_t, N>& perm, const std::array<uint8_t, N>* ori,
+                      int modulus, std::vector<PieceCycle>& cycles) {
+    std::array<uint8_t, N> next{};
+    for (size_t i = 0; i < N; i++) next[perm[i]] = i;
+
+    std::array<bool, N> seen{};
+    for (size_t start = 0; start < N; start++) {
+        if (seen[start]) continue;
+
+        PieceCycle cycle{kind, {}, 0};
+        size_t slot = start;
+        do {
+            seen[slot] = true;
+            cycle.slots.push_back(slot);
+            if (ori) cycle.twist += (*ori)[slot];
+            slot = next[slot];
+        } while (slot != start);
+        if (ori) cycle.twist %= modulus;
+
+        if (cycle.slots.size() > 1 || cycle.twist != 0) cycles.push_back(cycle);
+    }
+}
+
+std::vector<PieceCycle> cycleDecomposition(const CubieCube& a) {
+    std::vector<PieceCycle> cycles;
+    addCycles(CORNER_PIECE, a.cp, &a.co, 3, cycles);
+    addCycles(EDGE_PIECE, a.ep, &a.eo, 2, cycles);
+    addCycles<CENTER_COUNT>(CENTER_PIECE, a.ctr, nullptr, 1, cycles);
+    return cycles;
+}
+
+long order(const CubieCube& a) {
+    long result = 1;
+    for (const PieceCycle& cycle : cycleDecomposition(a)) {
+        // A twisted cycle only closes after the twist has gone all the way round
+        long length = cycle.slots.size();
+        if (cycle.twist != 0) length *= (cycle.kind == CORNER_PIECE) ? 3 : 2;
+        result = std::lcm(result, length);
+    }
+    return result;
+}
+
+static int permutationParity(const uint8_t* p, int n) {
+    int parity = 0;
+    for (int i = 0; i < n; i++) {
+        for (int j = i + 1; j < n; j++) {
+            if (p[j] < p[i]) parity ^= 1;
+        }
+    }
+    return parity;
+}
+
+bool isSolvable(const CubieCube& a) {
+    int seenCorners = 0, seenEdges = 0, twist = 0, flip = 0;
+    for (int i = 0; i < CORNER_COUNT; i++) {
+        if (a.cp[i] >= CORNER_COUNT || a.co[i] > 2) return false;
+        seenCorners |= 1 << a.cp[i];
+        twist += a.co[i];
+    }
+    for (int i = 0; i < EDGE_COUNT; i++) {
+        if (a.ep[i] >= EDGE_COUNT || a.eo[i] > 1) return false;
+        seenEdges |= 1 << a.ep[i];
+        flip += a.eo[i];
+    }
+    return seenCorners == (1 << CORNER_COUNT) - 1 && seenEdges == (1 << EDGE_COUNT) - 1
+        && twist % 3 == 0 && flip % 2 == 0
+        && permutationParity(a.cp.data(), CORNER_COUNT) == permutationParity(a.ep.data(), EDGE_COUNT);
+}
+
+std::string cycleNotation(const CubieCube& a) {
+    std::string text;
+    for (const PieceCycle& cycle : cycleDecomposition(a)) {
+        if (!text.empty()) text += ' ';
+        text += '(';
+        for (size_t k = 0; k < cycle.slots.size(); k++) {
+            if (k > 0) text += ' ';
+            switch (cycle.kind) {
+                case CORNER_PIECE: text += CORNER_NAMES[cycle.slots[k]]; break;
+                case EDGE_PIECE:   text += EDGE_NAMES[cycle.slots[k]];   break;
+                case CENTER_PIECE: text += CENTER_NAMES[cycle.slots[k]]; break;
+            }
+        }
+        text += ')';
+        // + for a corner twist of 1 or an edge flip, - for a twist of 2
+        if (cycle.twist == 1) text += '+';
+        else if (cycle.twist == 2) text += '-';
+    }
+    return text.empty() ? "identity" : text;
+}
@@ -0,0 +1,89 @@
+#ifndef CUBECORE_CUBEALGEBRA_H
+#define CUBECORE_CUBEALGEBRA_H
+
+#include "CubieCube.h"
+#include "Move.h"
+#include <string>
+#include <vector>
+
+// Group operations on CubieCube, the permutation and orientation of the 26
+// pieces (8 corners, 12 edges, 6 centers). Products read in move order:
+// compose(a, b) is a followed by b.
+
+constexpr CubieCube compose(const CubieCube& a, const CubieCube& b) {
+    CubieCube c = a;
+    c.multiply(b);
+    return c;
+}
+
+constexpr CubieCube inverse(const CubieCube& a) {
+    CubieCube r;
+    for (int i = 0; i < CORNER_COUNT; i++) {
+        r.cp[a.cp[i]] = i;
+        r.co[a.cp[i]] = a.co[i] ? 3 - a.co[i] : 0;
+    }
+    for (int i = 0; i < EDGE_COUNT; i++) {
+        r.ep[a.ep[i]] = i;
+        r.eo[a.ep[i]] = a.eo[i];
+    }
+    for (int i = 0; i < CENTER_COUNT; i++) {
+        r.ctr[a.ctr[i]] = i;
+    }
+    return r;
+}
+
+// setup, x, then setup undone
+constexpr CubieCube conjugate(const CubieCube& x, const CubieCube& setup) {
+    return compose(compose(setup, x), inverse(setup));
+}
+
+// a b a' b'
+constexpr CubieCube commutator(const CubieCube& a, const CubieCube& b) {
+    return compose(compose(a, b), compose(inverse(a), inverse(b)));
+}
+
+// a repeated n times; negative n repeats the inverse
+constexpr CubieCube power(const CubieCube& a, long n) {
+    CubieCube base = n < 0 ? inverse(a) : a;
+    if (n < 0) n = -n;
+    CubieCube result;
+    while (n > 0) {
+        if (n & 1) result.multiply(base);
+        base = compose(base, base);
+        n >>= 1;
+    }
+    return result;
+}
+
+inline CubieCube sequenceCube(const std::vector<Move>& moves) {
+    CubieCube c;
+    for (Move m : moves) c.applyMove(m);
+    return c;
+}
+
+// Smallest n > 0 with power(a, n) equal to the identity
+long order(const CubieCube& a);
+
+// True for the states face turns can reach: valid permutations, twists
+// summing to 0 mod 3, flips to 0 mod 2 and matching permutation parities
+bool isSolvable(const CubieCube& a);
+
+enum PieceKind : uint8_t { CORNER_PIECE, EDGE_PIECE, CENTER_PIECE };
+
+// One cycle of the decomposition: the piece in slots[0] moves to slots[1]
+// and so on around. twist is the orientation the pieces pick up per trip
+// around the cycle (mod 3 for corners, mod 2 for edges); a twisted or
+// flipped piece that stays home is a cycle of length 1.
+struct PieceCycle {
+    PieceKind kind;
+    std::vector<uint8_t> slots;
+    int twist;
+};
+
+// Cycles of every piece that moves or turns, corners then edges then centers
+std::vector<PieceCycle> cycleDecomposition(const CubieCube& a);
+
+// Cycles in slot names, e.g. "(URF UBR ULB) (UF UR)+", or "identity"
+std::string cycleNotation(const CubieCube& a);
+
+#endif // CUBECORE_CUBEALGEBRA_H
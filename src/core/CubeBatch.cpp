@@ -0,0 +1,301 @@
+#include "CubeBatch.h"
+#include "CpuFeatures.h"
+#include <algorithm>
+#include <cstring>
+
+// Value of each logical row in a solved cube
+static uint8_t solvedValue(int logical) {
+    if (logical < CORNER_COUNT) return logical;                        // cp
+    logical -= CORNER_COUNT;
+    if (logical < CORNER_COUNT) return 0;                              // co
+    logical -= CORNER_COUNT;
+    if (logical < EDGE_COUNT) return logical;                          // ep
+    logical -= EDGE_COUNT;
+    if (logical < EDGE_COUNT) return 0;                                // eo
+    return logical - EDGE_COUNT;                                       // ctr
+}
+
+// Per-move lookups for the AVX2 lane kernel, indexed [slot][move]: the slot
+// the piece comes from and the twist/flip it picks up, pre-shifted into the
+// packed byte layout the kernel works in (see applyMovesAVX2)
+struct BatchMoveTables {
+    alignas(32) uint8_t cornerSource[CORNER_COUNT][32];
+    alignas(32) uint8_t cornerTwist[CORNER_COUNT][32];
+    alignas(32) uint8_t edgeSource[EDGE_COUNT][32];
+    alignas(32) uint8_t edgeFlip[EDGE_COUNT][32];
+    alignas(32) uint8_t centerSource[CENTER_COUNT][32];
+
+    BatchMoveTables();
+};
+
+BatchMoveTables::BatchMoveTables() {
+    std::memset(this, 0, sizeof(*this));
+    for (int m = 0; m < MOVE_COUNT; m++) {
+        const CubieCube& t = MOVE_CUBES[m];
+        for (int i = 0; i < CORNER_COUNT; i++) {
+            cornerSource[i][m] = t.cp[i];
+            cornerTwist[i][m] = t.co[i] << 3;
+        }
+        for (int i = 0; i < EDGE_COUNT; i++) {
+            edgeSource[i][m] = t.ep[i];
+            edgeFlip[i][m] = t.eo[i] << 4;
+        }
+        for (int i = 0; i < CENTER_COUNT; i++) {
+            centerSource[i][m] = t.ctr[i];
+        }
+    }
+}
+
+static const BatchMoveTables TABLES;
+
+// The AVX2 kernels are compiled in every x86 build and used when the CPU has it
+static const bool USE_AVX2 = cpuLevel() >= CPU_AVX2;
+
+// Whole cache lines per row, and an odd number of them: with a power-of-two
+// stride every row maps to the same L1 set and the 92 streams of applyMoves()
+// evict each other
+static size_t paddedStride(size_t count) {
+    size_t lines = (count + 63) / 64;
+    if (lines % 2 == 0) lines++;
+    return lines * 64;
+}
+
+CubeBatch::CubeBatch(size_t count)
+    : count(count), stride(paddedStride(count)),
+      data(ROW_COUNT * stride), scratch(ROW_COUNT * stride) {
+    for (int r = 0; r < ROW_COUNT; r++) {
+        rowOf[r] = r;
+        std::fill(data.begin() + r * stride, data.begin() + (r + 1) * stride, solvedValue(r));
+    }
+}
+
+// --- Same move on every lane ---
+
+#if defined(CUBECORE_X86_KERNELS)
+// Whole 32-byte blocks of addTwist; returns how many bytes it did
+CUBECORE_TARGET("avx2")
+static size_t addTwistAVX2(uint8_t* p, uint8_t twist, size_t n) {
+    size_t k = 0;
+    const __m256i t = _mm256_set1_epi8((char)twist);
+    const __m256i three = _mm256_set1_epi8(3);
+    for (; k + 32 <= n; k += 32) {
+        __m256i v = _mm256_add_epi8(_mm256_loadu_si256((const __m256i*)(p + k)), t);
+        // v - 3 wraps around for v < 3, so the unsigned min is v mod 3
+        v = _mm256_min_epu8(v, _mm256_sub_epi8(v, three));
+        _mm256_storeu_si256((__m256i*)(p + k), v);
+    }
+    return k;
+}
+#endif
+
+static void addTwist(uint8_t* p, uint8_t twist, size_t n) {
+    size_t k = 0;
+#if defined(CUBECORE_X86_KERNELS)
+    if (USE_AVX2) k = addTwistAVX2(p, twist, n);
+#endif
+    for (; k < n; k++) {
+        uint8_t v = p[k] + twist;
+        p[k] = v >= 3 ? v - 3 : v;
+    }
+}
+
+static void flip(uint8_t* p, size_t n) {
+    for (size_t k = 0; k < n; k++) p[k] ^= 1;
+}
+
+void CubeBatch::applyMove(Move m) {
+    const CubieCube& t = MOVE_CUBES[m];
+    const std::array<uint8_t, ROW_COUNT> old = rowOf;
+
+    for (int i = 0; i < CORNER_COUNT; i++) {
+        rowOf[CP_ROW + i] = old[CP_ROW + t.cp[i]];
+        rowOf[CO_ROW + i] = old[CO_ROW + t.cp[i]];
+    }
+    for (int i = 0; i < EDGE_COUNT; i++) {
+        rowOf[EP_ROW + i] = old[EP_ROW + t.ep[i]];
+        rowOf[EO_ROW + i] = old[EO_ROW + t.ep[i]];
+    }
+    for (int i = 0; i < CENTER_COUNT; i++) {
+        rowOf[CTR_ROW + i] = old[CTR_ROW + t.ctr[i]];
+    }
+
+    for (int i = 0; i < CORNER_COUNT; i++) {
+        if (t.co[i]) addTwist(row(CO_ROW + i), t.co[i], stride);
+    }
+    for (int i = 0; i < EDGE_COUNT; i++) {
+        if (t.eo[i]) flip(row(EO_ROW + i), stride);
+    }
+}
+
+// --- One move per lane ---
+
+// in and out hold every row by logical index
+static void applyMovesScalar(const uint8_t* const* in, uint8_t* const* out, const Move* moves,
+                             size_t begin, size_t end) {
+    constexpr int CP_ROW = CubeBatch::CP_ROW, CO_ROW = CubeBatch::CO_ROW, EP_ROW = CubeBatch::EP_ROW,
+                  EO_ROW = CubeBatch::EO_ROW, CTR_ROW = CubeBatch::CTR_ROW;
+
+    for (size_t n = begin; n < end; n++) {
+        const CubieCube& t = MOVE_CUBES[moves[n]];
+        for (int i = 0; i < CORNER_COUNT; i++) {
+            out[CP_ROW + i][n] = in[CP_ROW + t.cp[i]][n];
+            uint8_t v = in[CO_ROW + t.cp[i]][n] + t.co[i];
+            out[CO_ROW + i][n] = v >= 3 ? v - 3 : v;
+        }
+        for (int i = 0; i < EDGE_COUNT; i++) {
+            out[EP_ROW + i][n] = in[EP_ROW + t.ep[i]][n];
+            out[EO_ROW + i][n] = in[EO_ROW + t.ep[i]][n] ^ t.eo[i];
+        }
+        for (int i = 0; i < CENTER_COUNT; i++) {
+            out[CTR_ROW + i][n] = in[CTR_ROW + t.ctr[i]][n];
+        }
+    }
+}
+
+#if defined(CUBECORE_X86_KERNELS)
+// 32 byte-table lookups at once: table has MOVE_COUNT (< 32) entries
+CUBECORE_TARGET("avx2")
+static inline __m256i lookup(const uint8_t* table, __m256i moves, __m256i upperHalf, __m256i upperIndex) {
+    __m256i lo = _mm256_shuffle_epi8(_mm256_broadcastsi128_si256(_mm_load_si128((const __m128i*)table)), moves);
+    __m256i hi = _mm256_shuffle_epi8(_mm256_broadcastsi128_si256(_mm_load_si128((const __m128i*)(table + 16))),
+                                     upperIndex);
+    return _mm256_blendv_epi8(lo, hi, upperHalf);
+}
+
+// Per lane, the candidate named by src (exactly one matches, so and/or merges)
+CUBECORE_TARGET("avx2")
+static inline __m256i select(const __m256i* candidates, int size, __m256i src) {
+    __m256i out = _mm256_setzero_si256();
+    for (int r = 0; r < size; r++) {
+        __m256i hit = _mm256_cmpeq_epi8(src, _mm256_set1_epi8((char)r));
+        out = _mm256_or_si256(out, _mm256_and_si256(hit, candidates[r]));
+    }
+    return out;
+}
+
+// 32 lanes of a row, from lane n on
+CUBECORE_TARGET("avx2")
+static inline __m256i load(const uint8_t* const* rows, int logical, size_t n) {
+    return _mm256_loadu_si256((const __m256i*)(rows[logical] + n));
+}
+
+CUBECORE_TARGET("avx2")
+static inline void store(uint8_t* const* rows, int logical, size_t n, __m256i v) {
+    _mm256_storeu_si256((__m256i*)(rows[logical] + n), v);
+}
+
+// Each block of 32 lanes is packed to one byte per piece (corner: cp | co << 3,
+// edge: ep | eo << 4) so one compare-select moves permutation and orientation
+CUBECORE_TARGET("avx2")
+static void applyMovesAVX2(const uint8_t* const* in, uint8_t* const* out, const Move* moves, size_t end) {
+    constexpr int CP_ROW = CubeBatch::CP_ROW, CO_ROW = CubeBatch::CO_ROW, EP_ROW = CubeBatch::EP_ROW,
+                  EO_ROW = CubeBatch::EO_ROW, CTR_ROW = CubeBatch::CTR_ROW;
+    const __m256i fifteen = _mm256_set1_epi8(15);
+    const __m256i sixteen = _mm256_set1_epi8(16);
+    const __m256i twentyFour = _mm256_set1_epi8(24);
+    const __m256i seven = _mm256_set1_epi8(7);
+    const __m256i one = _mm256_set1_epi8(1);
+
+
+    for (size_t n = 0; n + 32 <= end; n += 32) {
+        __m256i mv = _mm256_loadu_si256((const __m256i*)(moves + n));
+        __m256i upperHalf = _mm256_cmpgt_epi8(mv, fifteen);
+        __m256i upperIndex = _mm256_sub_epi8(mv, sixteen);
+
+        __m256i corners[CORNER_COUNT], edges[EDGE_COUNT], centers[CENTER_COUNT];
+        // Orientations are < 3 and < 2, so 16-bit shifts never carry across bytes
+        for (int i = 0; i < CORNER_COUNT; i++) {
+            corners[i] = _mm256_or_si256(load(in, CP_ROW + i, n), _mm256_slli_epi16(load(in, CO_ROW + i, n), 3));
+        }
+        for (int i = 0; i < EDGE_COUNT; i++) {
+            edges[i] = _mm256_or_si256(load(in, EP_ROW + i, n), _mm256_slli_epi16(load(in, EO_ROW + i, n), 4));
+        }
+        for (int i = 0; i < CENTER_COUNT; i++) {
+            centers[i] = load(in, CTR_ROW + i, n);
+        }
+
+        for (int i = 0; i < CORNER_COUNT; i++) {
+            __m256i v = select(corners, CORNER_COUNT,
+                               lookup(TABLES.cornerSource[i], mv, upperHalf, upperIndex));
+            v = _mm256_add_epi8(v, lookup(TABLES.cornerTwist[i], mv, upperHalf, upperIndex));
+            // Twist back into 0..2: v - 24 wraps around unless the twist reached 3
+            v = _mm256_min_epu8(v, _mm256_sub_epi8(v, twentyFour));
+            store(out, CP_ROW + i, n, _mm256_and_si256(v, seven));
+            store(out, CO_ROW + i, n, _mm256_and_si256(_mm256_srli_epi16(v, 3), seven));
+        }
+        for (int i = 0; i < EDGE_COUNT; i++) {
+            __m256i v = select(edges, EDGE_COUNT, lookup(TABLES.edgeSource[i], mv, upperHalf, upperIndex));
+            v = _mm256_xor_si256(v, lookup(TABLES.edgeFlip[i], mv, upperHalf, upperIndex));
+            store(out, EP_ROW + i, n, _mm256_and_si256(v, fifteen));
+            store(out, EO_ROW + i, n, _mm256_and_si256(_mm256_srli_epi16(v, 4), one));
+        }
+        for (int i = 0; i < CENTER_COUNT; i++) {
+            store(out, CTR_ROW + i, n,
+                  select(centers, CENTER_COUNT, lookup(TABLES.centerSource[i], mv, upperHalf, upperIndex)));
+        }
+    }
+}
+#endif
+
+void CubeBatch::applyMoves(const Move* moves) {
+    // Row pointers up front: byte stores would otherwise force rowOf reloads
+    const uint8_t* in[ROW_COUNT];
+    uint8_t* out[ROW_COUNT];
+    for (int r = 0; r < ROW_COUNT; r++) {
+        in[r] = row(r);
+        out[r] = scratch.data() + r * stride;
+    }
+
+    size_t vectorEnd = 0;
+#if defined(CUBECORE_X86_KERNELS)
+    if (USE_AVX2) {
+        vectorEnd = count / 32 * 32;
+        applyMovesAVX2(in, out, moves, vectorEnd);
+    }
+#endif
+    applyMovesScalar(in, out, moves, vectorEnd, count);
+
+    // scratch now holds every row in logical order
+    data.swap(scratch);
+    for (int r = 0; r < ROW_COUNT; r++) rowOf[r] = r;
+}
+
+CubieCube CubeBatch::get(size_t lane) const {
+    CubieCube c;
+    for (int i = 0; i < CORNER_COUNT; i++) {
+        c.cp[i] = row(CP_ROW + i)[lane];
+        c.co[i] = row(CO_ROW + i)[lane];
+    }
+    for (int i = 0; i < EDGE_COUNT; i++) {
+        c.ep[i] = row(EP_ROW + i)[lane];
+        c.eo[i] = row(EO_ROW + i)[lane];
+    }
+    for (int i = 0; i < CENTER_COUNT; i++) {
+        c.ctr[i] = row(CTR_ROW + i)[lane];
+    }
+    return c;
+}
+
+void CubeBatch::set(size_t lane, const CubieCube& cube) {
+    for (int i = 0; i < CORNER_COUNT; i++) {
+        row(CP_ROW + i)[lane] = cube.cp[i];
+        row(CO_ROW + i)[lane] = cube.co[i];
+    }
+    for (int i = 0; i < EDGE_COUNT; i++) {
+        row(EP_ROW + i)[lane] = cube.ep[i];
+        row(EO_ROW + i)[lane] = cube.eo[i];
+    }
+    for (int i = 0; i < CENTER_COUNT; i++) {
+        row(CTR_ROW + i)[lane] = cube.ctr[i];
+    }
+}
+
+size_t CubeBatch::countSolved() const {
+    std::vector<uint8_t> solved(count, 1);
+    for (int r = 0; r < ROW_COUNT; r++) {
+        const uint8_t* p = row(r);
+        const uint8_t expected = solvedValue(r);
+        for (size_t n = 0; n < count; n++) solved[n] &= (p[n] == expected);
+    }
+    return std::count(solved.begin(), solved.end(), 1);
+}
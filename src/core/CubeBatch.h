@@ -0,0 +1,59 @@
+#ifndef CUBECORE_CUBEBATCH_H
+#define CUBECORE_CUBEBATCH_H
+
+#include "CubieCube.h"
+#include "Move.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// N independent cubie cubes in structure-of-arrays layout: one row per cubie
+// field (cp[0..7], co[0..7], ep[0..11], eo[0..11], ctr[0..5]) holding that
+// field for every lane, so a move is processed for many cubes at once.
+//
+// applyMove() turns every lane the same way. Rows are reached through a
+// logical-to-physical row index, so the permutation part of the move only
+// reorders 46 indices; only the twisted/flipped orientation rows touch lane
+// data. applyMoves() takes one move per lane and uses an AVX2 lookup and
+// compare-select kernel when the CPU has AVX2.
+class CubeBatch {
+public:
+    static constexpr int ROW_COUNT = 2 * CORNER_COUNT + 2 * EDGE_COUNT + CENTER_COUNT;
+
+    // count solved cubes
+    explicit CubeBatch(size_t count);
+
+    size_t size() const { return count; }
+
+    void applyMove(Move m);
+    // moves[lane] is applied to each lane; the array must hold size() moves
+    void applyMoves(const Move* moves);
+    void applyMoves(const std::vector<Move>& moves) { applyMoves(moves.data()); }
+
+    CubieCube get(size_t lane) const;
+    void set(size_t lane, const CubieCube& cube);
+    bool isSolved(size_t lane) const { return get(lane).isSolved(); }
+    size_t countSolved() const;
+
+    // First logical row of each field
+    static constexpr int CP_ROW = 0;
+    static constexpr int CO_ROW = CP_ROW + CORNER_COUNT;
+    static constexpr int EP_ROW = CO_ROW + CORNER_COUNT;
+    static constexpr int EO_ROW = EP_ROW + EDGE_COUNT;
+    static constexpr int CTR_ROW = EO_ROW + EDGE_COUNT;
+
+private:
+
+    size_t count;
+    size_t stride;                             // lanes per row, see paddedStride()
+    std::vector<uint8_t> data;
+    std::vector<uint8_t> scratch;              // output rows of applyMoves()
+    std::array<uint8_t, ROW_COUNT> rowOf;      // logical row -> physical row
+
+    uint8_t* row(int logical) { return data.data() + rowOf[logical] * stride; }
+    const uint8_t* row(int logical) const { return data.data() + rowOf[logical] * stride; }
+
+};
+
+#endif // CUBECORE_CUBEBATCH_H
@@ -0,0 +1,283 @@
+#include "CubeState.h"
+
+// splitmix64 finalizer: a fixed pseudo-random key for each index
+static uint64_t mixKey(uint64_t x) {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+namespace {
+
+constexpr int ORIENTATION_COUNT = 36;
+
+// Zobrist keys by piece, slot and orientation, built on first use
+struct ZobristTables {
+    std::array<uint64_t, CubeState::PIECE_COUNT * CubeState::SLOT_COUNT * ORIENTATION_COUNT> key;
+    // Orientation after a layer turn, by axis * 2 + clockwise
+    std::array<std::array<uint8_t, ORIENTATION_COUNT>, 6> turn;
+};
+
+const ZobristTables& zobristTables() {
+    static const ZobristTables tables = [] {
+        ZobristTables t;
+        for (size_t i = 0; i < t.key.size(); i++) t.key[i] = mixKey(i);
+        for (int kind = 0; kind < 6; kind++) {
+            // Where a sticker facing each side ends up: follow the side indices
+            std::array<char, 6> sides = {0, 1, 2, 3, 4, 5};
+            bool clockwise = kind % 2;
+            if (kind / 2 == 0) CubeState::rotateAroundX(sides, clockwise);
+            else if (kind / 2 == 1) CubeState::rotateAroundY(sides, clockwise);
+            else CubeState::rotateAroundZ(sides, clockwise);
+            int moved[6];
+            for (int f = 0; f < 6; f++) moved[(int)sides[f]] = f;
+            for (int o = 0; o < ORIENTATION_COUNT; o++) {
+                t.turn[kind][o] = (uint8_t)(moved[o / 6] * 6 + moved[o % 6]);
+            }
+        }
+        return t;
+    }();
+    return tables;
+}
+
+} // namespace
+
+CubeState::CubeState() {
+    int id = 0;
+    slotPiece.fill(-1);
+
+    for (int x = -1; x <= 1; x++) {
+        for (int y = -1; y <= 1; y++) {
+            for (int z = -1; z <= 1; z++) {
+                // Skip Center
+                if (x == 0 && y == 0 && z == 0) continue;
+
+                GridPos pos{x, y, z};
+                pieces[id].pos = pos;
+                pieces[id].faces = getInitialColors(pos);
+                solvedPosition[id] = pos;
+                slotPiece[slotIndex(pos)] = id;
+
+                // At home every sticker faces its own side
+                int first = -1, second = -1;
+                for (int f = 0; f < 6; f++) {
+                    if (pieces[id].faces[f] == '?') continue;
+                    if (first < 0) first = f;
+                    else if (second < 0) second = f;
+                }
+                orientation[id] = (uint8_t)(first * 6 + (second < 0 ? first : second));
+                id++;
+            }
+        }
+    }
+
+    for (int i = 0; i < PIECE_COUNT; i++) hash ^= pieceKey(i);
+}
+
+uint64_t CubeState::pieceKey(int id) const {
+    return zobristTables().key[((size_t)id * SLOT_COUNT + slotIndex(pieces[id].pos)) * ORIENTATION_COUNT +
+                               orientation[id]];
+}
+
+uint64_t CubeState::computeHash() const {
+    uint64_t h = 0;
+    for (int id = 0; id < PIECE_COUNT; id++) {
+        // The sides now showing the colors of the piece's first two home
+        // sides; a piece's colors are distinct, so each shows on one side
+        std::array<char, 6> home = getInitialColors(solvedPosition[id]);
+        int sides[2] = {-1, -1}, found = 0;
+        for (int f = 0; f < 6 && found < 2; f++) {
+            if (home[f] == '?') continue;
+            for (int s = 0; s < 6; s++) {
+                if (pieces[id].faces[s] == home[f]) sides[found] = s;
+            }
+            found++;
+        }
+        int o = sides[0] * 6 + (found < 2 ? sides[0] : sides[1]);
+        h ^= zobristTables().key[((size_t)id * SLOT_COUNT + slotIndex(pieces[id].pos)) * ORIENTATION_COUNT + o];
+    }
+    return h;
+}
+
+// --- Helper: Get Initial Colors for a Cubie ---
+std::array<char, 6> CubeState::getInitialColors(GridPos pos) {
+    std::array<char, 6> colors;
+    colors.fill('?'); // Internal faces have no sticker
+
+    // Front/Back (Z-Axis)
+    if (pos.z == 1) colors[FRONT] = 'B';
+    if (pos.z == -1) colors[BACK] = 'G';
+
+    // Right/Left (X-Axis)
+    if (pos.x == 1) colors[RIGHT] = 'R';
+    if (pos.x == -1) colors[LEFT] = 'O';
+
+    // Top/Bottom (Y-Axis)
+    if (pos.y == 1) colors[UP] = 'W';
+    if (pos.y == -1) colors[DOWN] = 'Y';
+
+    return colors;
+}
+
+GridPos CubeState::calculateNewGridPosition(GridPos p, char axis, bool clockwise) {
+    switch(axis)
+    {
+        case 'X':
+            if (clockwise)  return { p.x, -p.z,  p.y };   // (y,z) -> (-z,y)
+            else            return { p.x,  p.z, -p.y };   // (y,z) -> (z,-y)
+
+        case 'Y':
+            if (clockwise)  return {  p.z, p.y, -p.x };   // (x,z) -> (z,-x)
+            else            return { -p.z, p.y,  p.x };   // (x,z) -> (-z,x)
+
+        case 'Z':
+            if (clockwise)  return { -p.y, p.x, p.z };    // (x,y) -> (-y,x)
+            else            return {  p.y, -p.x, p.z };   // (x,y) -> (y,-x)
+    }
+    return p;
+}
+
+void CubeState::rotateAroundY(std::array<char, 6>& faces, bool clockwise) {
+    // rotation around cube Y axis (U / D moves affect pieces' local colors)
+    // Cycle: FRONT -> RIGHT -> BACK -> LEFT -> FRONT   (for clockwise Y)
+    const std::array<char, 6> old = faces;
+
+    if (clockwise) {
+        faces[FRONT] = old[LEFT];
+        faces[RIGHT] = old[FRONT];
+        faces[BACK]  = old[RIGHT];
+        faces[LEFT]  = old[BACK];
+    } else {
+        faces[FRONT] = old[RIGHT];
+        faces[LEFT]  = old[FRONT];
+        faces[BACK]  = old[LEFT];
+        faces[RIGHT] = old[BACK];
+    }
+}
+
+void CubeState::rotateAroundX(std::array<char, 6>& faces, bool clockwise) {
+    // rotation around X axis (R / L)
+    // Cycle: UP -> FRONT -> DOWN -> BACK -> UP   (for clockwise X)
+    const std::array<char, 6> old = faces;
+
+    if (clockwise) {
+        faces[FRONT] = old[UP];
+        faces[DOWN]  = old[FRONT];
+        faces[BACK]  = old[DOWN];
+        faces[UP]    = old[BACK];
+    } else {
+        faces[FRONT] = old[DOWN];
+        faces[UP]    = old[FRONT];
+        faces[BACK]  = old[UP];
+        faces[DOWN]  = old[BACK];
+    }
+}
+
+void CubeState::rotateAroundZ(std::array<char, 6>& faces, bool clockwise) {
+    // rotation around Z axis (F / B)
+    // Cycle: RIGHT -> UP -> LEFT -> DOWN -> RIGHT   (for clockwise Z)
+    const std::array<char, 6> old = faces;
+
+    if (clockwise) {
+        faces[RIGHT] = old[DOWN];
+        faces[UP]    = old[RIGHT];
+        faces[LEFT]  = old[UP];
+        faces[DOWN]  = old[LEFT];
+    } else {
+        faces[RIGHT] = old[UP];
+        faces[DOWN]  = old[RIGHT];
+        faces[LEFT]  = old[DOWN];
+        faces[UP]    = old[LEFT];
+    }
+}
+
+void CubeState::applyTurn(char axis, int layer, bool clockwise) {
+    // The 9 pieces of the layer, read from its slots before any of them move
+    int layerPieces[9];
+    int count = 0;
+    for (int a = -1; a <= 1; a++) {
+        for (int b = -1; b <= 1; b++) {
+            GridPos slot = (axis == 'X') ? GridPos{layer, a, b}
+                         : (axis == 'Y') ? GridPos{a, layer, b}
+                                         : GridPos{a, b, layer};
+            int id = slotPiece[slotIndex(slot)];
+            if (id >= 0) layerPieces[count++] = id;
+        }
+    }
+
+    const std::array<uint8_t, ORIENTATION_COUNT>& turn = zobristTables().turn[(axis - 'X') * 2 + clockwise];
+    for (int k = 0; k < count; k++) {
+        int id = layerPieces[k];
+        CubePiece& piece = pieces[id];
+        hash ^= pieceKey(id);
+
+        if (axis == 'X') rotateAroundX(piece.faces, clockwise);
+        else if (axis == 'Y') rotateAroundY(piece.faces, clockwise);
+        else if (axis == 'Z') rotateAroundZ(piece.faces, clockwise);
+
+        piece.pos = calculateNewGridPosition(piece.pos, axis, clockwise);
+        slotPiece[slotIndex(piece.pos)] = id;
+        orientation[id] = turn[orientation[id]];
+        hash ^= pieceKey(id);
+    }
+}
+
+bool CubeState::parseMove(const std::string& move, char& axis, int& layer, bool& clockwise) {
+    if (move.empty() || move.size() > 2) return false;
+    if (move.size() == 2 && move[1] != '\'') return false;
+    bool prime = move.size() == 2;
+
+    // Face letter -> axis, layer and the direction of the unprimed turn
+    switch (move[0]) {
+        case 'R': axis = 'X'; layer =  1; clockwise = true;  break;
+        case 'L': axis = 'X'; layer = -1; clockwise = false; break;
+        case 'U': axis = 'Y'; layer =  1; clockwise = true;  break;
+        case 'D': axis = 'Y'; layer = -1; clockwise = false; break;
+        case 'F': axis = 'Z'; layer =  1; clockwise = true;  break;
+        case 'B': axis = 'Z'; layer = -1; clockwise = false; break;
+        // Middle Layer Movements
+        case 'X': axis = 'X'; layer =  0; clockwise = true;  break;
+        case 'Y': axis = 'Y'; layer =  0; clockwise = true;  break;
+        case 'Z': axis = 'Z'; layer =  0; clockwise = true;  break;
+        default: return false;
+    }
+    if (prime) clockwise = !clockwise;
+    return true;
+}
+
+bool CubeState::applyMove(const std::string& move) {
+    char axis;
+    int layer;
+    bool clockwise;
+    if (!parseMove(move, axis, layer, clockwise)) return false;
+
+    applyTurn(axis, layer, clockwise);
+    return true;
+}
+
+bool CubeState::isSolved() const {
+    for (int id = 0; id < PIECE_COUNT; id++) {
+        const CubePiece& piece = pieces[id];
+        if (piece.pos != solvedPosition[id] || piece.faces != getInitialColors(solvedPosition[id])) return false;
+    }
+    return true;
+}
+
+bool CubeState::isSolvedUpToRotation() const {
+    // Every sticker facing outward must match the first one seen on that face
+    std::array<char, 6> faceColor;
+    faceColor.fill('\0');
+
+    for (const CubePiece& piece : pieces) {
+        const int onFace[6] = { piece.pos.z == 1, piece.pos.z == -1, piece.pos.x == 1,
+                                piece.pos.x == -1, piece.pos.y == 1, piece.pos.y == -1 };
+        for (int f = 0; f < 6; f++) {
+            if (!onFace[f]) continue;
+            if (faceColor[f] == '\0') faceColor[f] = piece.faces[f];
+            else if (faceColor[f] != piece.faces[f]) return false;
+        }
+    }
+    return true;
+}
+
@@ -0,0 +1,104 @@
+#ifndef CUBECORE_CUBESTATE_H
+#define CUBECORE_CUBESTATE_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+// Headless cube state: no GLFW, glad or Shader dependency. RubiksCube and
+// Cubelet render this state; the Solver and batch tools use it directly.
+
+enum Face { FRONT=0, BACK=1, RIGHT=2, LEFT=3, UP=4, DOWN=5 };
+
+// Grid coordinate of a piece, each component is -1, 0 or 1
+struct GridPos {
+    int x = 0, y = 0, z = 0;
+
+    bool operator==(const GridPos& o) const { return x == o.x && y == o.y && z == o.z; }
+    bool operator!=(const GridPos& o) const { return !(*this == o); }
+};
+
+// One of the 26 visible pieces. Sticker colors use the same character codes
+// as the Solver: 'W','Y','B','G','R','O', and '?' for an internal face.
+struct CubePiece {
+    GridPos pos;
+    std::array<char, 6> faces;
+
+    char getFaceColor(Face face) const { return faces[face]; }
+};
+
+class CubeState {
+public:
+    static constexpr int PIECE_COUNT = 26;
+    static constexpr int SLOT_COUNT = 27; // grid cells, including the hidden core
+
+    // Builds a solved cube. Piece ids follow the x, y, z loop order used by
+    // RubiksCube::initNumbering (center of the cube skipped).
+    CubeState();
+
+    // Turns every piece in the given layer. axis is 'X', 'Y' or 'Z', layer is
+    // -1, 0 or 1, and clockwise matches a positive startRotation() angle.
+    void applyTurn(char axis, int layer, bool clockwise);
+
+    // Applies a move in RubiksCube::executeMove notation ("R", "U'", "X", ...).
+    // Returns false and leaves the state untouched for unknown moves.
+    bool applyMove(const std::string& move);
+
+    // True when every piece is back in its solved position with its home
+    // colors, so the state equals a fresh CubeState (a center's spin aside)
+    bool isSolved() const;
+
+    // True when every face shows a single color: solved, or solved and then
+    // turned as a whole (R X L' style), as a solve that rotates the cube ends
+    bool isSolvedUpToRotation() const;
+
+    // 64-bit Zobrist hash of the state: the XOR of one random key per piece
+    // for its slot and orientation, updated on every turn by swapping the keys
+    // of the pieces that moved. Equal states hash equal.
+    uint64_t getHash() const { return hash; }
+    // The same hash worked out from scratch, from where each piece is and
+    // which way its stickers face, without the tracked orientations; for
+    // checking getHash()
+    uint64_t computeHash() const;
+
+    const CubePiece& getPiece(int id) const { return pieces[id]; }
+    // Constant-time slot lookups; -1 / nullptr for the core or off-grid cells
+    int getPieceIdAt(GridPos pos) const {
+        int slot = slotIndex(pos);
+        return slot < 0 ? -1 : slotPiece[slot];
+    }
+    const CubePiece* getPieceAt(GridPos pos) const {
+        int id = getPieceIdAt(pos);
+        return id < 0 ? nullptr : &pieces[id];
+    }
+    GridPos getSolvedPosition(int id) const { return solvedPosition[id]; }
+
+    // Geometry helpers shared with the render layer
+    static std::array<char, 6> getInitialColors(GridPos pos);
+    static GridPos calculateNewGridPosition(GridPos p, char axis, bool clockwise);
+    static void rotateAroundX(std::array<char, 6>& faces, bool clockwise);
+    static void rotateAroundY(std::array<char, 6>& faces, bool clockwise);
+    static void rotateAroundZ(std::array<char, 6>& faces, bool clockwise);
+
+    // 0..26 for a grid cell, -1 when a component is outside -1..1
+    static int slotIndex(GridPos p) {
+        if (p.x < -1 || p.x > 1 || p.y < -1 || p.y > 1 || p.z < -1 || p.z > 1) return -1;
+        return (p.x + 1) * 9 + (p.y + 1) * 3 + (p.z + 1);
+    }
+
+    // Maps executeMove notation to a layer turn
+    static bool parseMove(const std::string& move, char& axis, int& layer, bool& clockwise);
+
+private:
+    std::array<CubePiece, PIECE_COUNT> pieces;
+    std::array<GridPos, PIECE_COUNT> solvedPosition;
+    std::array<int8_t, SLOT_COUNT> slotPiece;   // piece id in each slot, kept in step with pieces[].pos
+    // Where each piece's first two stickers (in Face order) now point, as
+    // first * 6 + second; a center's one sticker counts twice
+    std::array<uint8_t, PIECE_COUNT> orientation;
+    uint64_t hash = 0;
+
+    uint64_t pieceKey(int id) const;
+};
+
+#endif // CUBECORE_CUBESTATE_H
@@ -0,0 +1,69 @@
+#include "CubieCube.h"
+
+// Slot lookups by grid position, built from the facelet tables
+static GridPos slotPosition(const Face* faces, int count) {
+    GridPos p;
+    for (int i = 0; i < count; i++) {
+        switch (faces[i]) {
+            case FRONT: p.z = 1;  break;
+            case BACK:  p.z = -1; break;
+            case RIGHT: p.x = 1;  break;
+            case LEFT:  p.x = -1; break;
+            case UP:    p.y = 1;  break;
+            case DOWN:  p.y = -1; break;
+        }
+    }
+    return p;
+}
+
+static int cornerSlotAt(GridPos p) {
+    for (int i = 0; i < CORNER_COUNT; i++) {
+        if (slotPosition(CORNER_FACES[i], 3) == p) return i;
+    }
+    return -1;
+}
+
+static int edgeSlotAt(GridPos p) {
+    for (int i = 0; i < EDGE_COUNT; i++) {
+        if (slotPosition(EDGE_FACES[i], 2) == p) return i;
+    }
+    return -1;
+}
+
+static int centerSlotAt(GridPos p) {
+    for (int i = 0; i < CENTER_COUNT; i++) {
+        if (slotPosition(&CENTER_FACES[i], 1) == p) return i;
+    }
+    return -1;
+}
+
+CubieCube CubieCube::fromCubeState(const CubeState& state) {
+    CubieCube c;
+
+    for (int id = 0; id < CubeState::PIECE_COUNT; id++) {
+        const CubePiece& piece = state.getPiece(id);
+        GridPos home = state.getSolvedPosition(id);
+        const std::array<char, 6> homeColors = CubeState::getInitialColors(home);
+        int zeroCount = (home.x == 0) + (home.y == 0) + (home.z == 0);
+
+        if (zeroCount == 0) {
+            int slot = cornerSlotAt(piece.pos);
+            int corner = cornerSlotAt(home);
+            // Reference sticker is the piece's U or D color
+            char ref = homeColors[CORNER_FACES[corner][0]];
+            c.cp[slot] = corner;
+            for (int k = 0; k < 3; k++) {
+                if (piece.faces[CORNER_FACES[slot][k]] == ref) c.co[slot] = k;
+            }
+        } else if (zeroCount == 1) {
+            int slot = edgeSlotAt(piece.pos);
+            int edge = edgeSlotAt(home);
+            char ref = homeColors[EDGE_FACES[edge][0]];
+            c.ep[slot] = edge;
+            c.eo[slot] = piece.faces[EDGE_FACES[slot][0]] == ref ? 0 : 1;
+        } else {
+            c.ctr[centerSlotAt(piece.pos)] = centerSlotAt(home);
+        }
+    }
+    return c;
+}
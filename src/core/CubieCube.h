@@ -0,0 +1,125 @@
+#ifndef CUBECORE_CUBIECUBE_H
+#define CUBECORE_CUBIECUBE_H
+
+#include "CubeState.h"
+#include "Move.h"
+#include <array>
+#include <cstdint>
+
+// Corner and edge slots. A corner's first facelet is on U or D, an edge's
+// first facelet is on U/D (or F/B for the middle layer edges); orientation
+// counts how far that reference sticker has moved around the piece.
+enum Corner : uint8_t { URF, UFL, ULB, UBR, DFR, DLF, DBL, DRB };
+enum Edge : uint8_t { UR, UF, UL, UB, DR, DF, DL, DB, FR, FL, BL, BR };
+
+constexpr int CORNER_COUNT = 8;
+constexpr int EDGE_COUNT = 12;
+constexpr int CENTER_COUNT = 6;
+
+// Facelets of each slot, listed from the reference facelet
+constexpr Face CORNER_FACES[CORNER_COUNT][3] = {
+    {UP, RIGHT, FRONT}, {UP, FRONT, LEFT}, {UP, LEFT, BACK}, {UP, BACK, RIGHT},
+    {DOWN, FRONT, RIGHT}, {DOWN, LEFT, FRONT}, {DOWN, BACK, LEFT}, {DOWN, RIGHT, BACK}
+};
+constexpr Face EDGE_FACES[EDGE_COUNT][2] = {
+    {UP, RIGHT}, {UP, FRONT}, {UP, LEFT}, {UP, BACK},
+    {DOWN, RIGHT}, {DOWN, FRONT}, {DOWN, LEFT}, {DOWN, BACK},
+    {FRONT, RIGHT}, {FRONT, LEFT}, {BACK, LEFT}, {BACK, RIGHT}
+};
+// Center slots in U R F D L B order
+constexpr Face CENTER_FACES[CENTER_COUNT] = {UP, RIGHT, FRONT, DOWN, LEFT, BACK};
+
+// Cubie-level cube state (46 bytes). cp[i] is the corner sitting in slot i and
+// co[i] its twist (0..2); ep/eo are the same for edges (flip 0..1) and ctr
+// tracks the centers moved by the slice turns.
+struct CubieCube {
+    std::array<uint8_t, CORNER_COUNT> cp{0, 1, 2, 3, 4, 5, 6, 7};
+    std::array<uint8_t, CORNER_COUNT> co{};
+    std::array<uint8_t, EDGE_COUNT> ep{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+    std::array<uint8_t, EDGE_COUNT> eo{};
+    std::array<uint8_t, CENTER_COUNT> ctr{0, 1, 2, 3, 4, 5};
+
+    constexpr CubieCube() = default;
+    constexpr CubieCube(const std::array<uint8_t, CORNER_COUNT>& cp, const std::array<uint8_t, CORNER_COUNT>& co,
+                        const std::array<uint8_t, EDGE_COUNT>& ep, const std::array<uint8_t, EDGE_COUNT>& eo,
+                        const std::array<uint8_t, CENTER_COUNT>& ctr)
+        : cp(cp), co(co), ep(ep), eo(eo), ctr(ctr) {}
+
+    // this = this * b, i.e. b is applied after the current state
+    constexpr void multiply(const CubieCube& b);
+    constexpr void applyMove(Move m);
+
+    // True only for the identity (whole-cube rotations are not folded away)
+    constexpr bool isSolved() const { return *this == CubieCube(); }
+
+    constexpr bool operator==(const CubieCube& o) const {
+        for (int i = 0; i < CORNER_COUNT; i++) if (cp[i] != o.cp[i] || co[i] != o.co[i]) return false;
+        for (int i = 0; i < EDGE_COUNT; i++) if (ep[i] != o.ep[i] || eo[i] != o.eo[i]) return false;
+        for (int i = 0; i < CENTER_COUNT; i++) if (ctr[i] != o.ctr[i]) return false;
+        return true;
+    }
+    constexpr bool operator!=(const CubieCube& o) const { return !(*this == o); }
+
+    // Reads piece positions and sticker orientation from the piece-level state
+    static CubieCube fromCubeState(const CubeState& state);
+};
+
+constexpr void CubieCube::multiply(const CubieCube& b) {
+    const CubieCube a = *this;
+    for (int i = 0; i < CORNER_COUNT; i++) {
+        cp[i] = a.cp[b.cp[i]];
+        uint8_t twist = a.co[b.cp[i]] + b.co[i];
+        co[i] = twist >= 3 ? twist - 3 : twist;
+    }
+    for (int i = 0; i < EDGE_COUNT; i++) {
+        ep[i] = a.ep[b.ep[i]];
+        eo[i] = a.eo[b.ep[i]] ^ b.eo[i];
+    }
+    for (int i = 0; i < CENTER_COUNT; i++) {
+        ctr[i] = a.ctr[b.ctr[i]];
+    }
+}
+
+// Quarter turns in executeMove direction, derived from the grid rotations in
+// CubeState::calculateNewGridPosition: U R F D L B, then the X Y Z slices
+constexpr CubieCube BASIC_MOVE_CUBES[9] = {
+    {{1, 2, 3, 0, 4, 5, 6, 7}, {0, 0, 0, 0, 0, 0, 0, 0},
+     {1, 2, 3, 0, 4, 5, 6, 7, 8, 9, 10, 11}, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}, {0, 1, 2, 3, 4, 5}},
+    {{3, 1, 2, 7, 0, 5, 6, 4}, {2, 0, 0, 1, 1, 0, 0, 2},
+     {11, 1, 2, 3, 8, 5, 6, 7, 0, 9, 10, 4}, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}, {0, 1, 2, 3, 4, 5}},
+    {{4, 0, 2, 3, 5, 1, 6, 7}, {1, 2, 0, 0, 2, 1, 0, 0},
+     {0, 8, 2, 3, 4, 9, 6, 7, 5, 1, 10, 11}, {0, 1, 0, 0, 0, 1, 0, 0, 1, 1, 0, 0}, {0, 1, 2, 3, 4, 5}},
+    {{0, 1, 2, 3, 7, 4, 5, 6}, {0, 0, 0, 0, 0, 0, 0, 0},
+     {0, 1, 2, 3, 7, 4, 5, 6, 8, 9, 10, 11}, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}, {0, 1, 2, 3, 4, 5}},
+    {{0, 5, 1, 3, 4, 6, 2, 7}, {0, 1, 2, 0, 0, 2, 1, 0},
+     {0, 1, 9, 3, 4, 5, 10, 7, 8, 6, 2, 11}, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}, {0, 1, 2, 3, 4, 5}},
+    {{0, 1, 6, 2, 4, 5, 7, 3}, {0, 0, 1, 2, 0, 0, 2, 1},
+     {0, 1, 2, 10, 4, 5, 6, 11, 8, 9, 7, 3}, {0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 1, 1}, {0, 1, 2, 3, 4, 5}},
+    {{0, 1, 2, 3, 4, 5, 6, 7}, {0, 0, 0, 0, 0, 0, 0, 0},
+     {0, 3, 2, 7, 4, 1, 6, 5, 8, 9, 10, 11}, {0, 1, 0, 1, 0, 1, 0, 1, 0, 0, 0, 0}, {5, 1, 0, 2, 4, 3}},
+    {{0, 1, 2, 3, 4, 5, 6, 7}, {0, 0, 0, 0, 0, 0, 0, 0},
+     {0, 1, 2, 3, 4, 5, 6, 7, 9, 10, 11, 8}, {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1}, {0, 2, 4, 3, 5, 1}},
+    {{0, 1, 2, 3, 4, 5, 6, 7}, {0, 0, 0, 0, 0, 0, 0, 0},
+     {4, 1, 0, 3, 6, 5, 2, 7, 8, 9, 10, 11}, {1, 0, 1, 0, 1, 0, 1, 0, 0, 0, 0, 0}, {1, 3, 2, 4, 0, 5}},
+};
+
+constexpr std::array<CubieCube, MOVE_COUNT> makeMoveCubes() {
+    std::array<CubieCube, MOVE_COUNT> table{};
+    for (int face = 0; face < 9; face++) {
+        CubieCube c;
+        for (int power = 1; power <= 3; power++) {
+            c.multiply(BASIC_MOVE_CUBES[face]);
+            table[makeMove(face, power)] = c;
+        }
+    }
+    return table;
+}
+
+// Permutation/orientation table for every move, built at compile time
+inline constexpr std::array<CubieCube, MOVE_COUNT> MOVE_CUBES = makeMoveCubes();
+
+constexpr void CubieCube::applyMove(Move m) {
+    multiply(MOVE_CUBES[m]);
+}
+
+#endif // CUBECORE_CUBIECUBE_H
@@ -0,0 +1,54 @@
+#include "Move.h"
+#include <sstream>
+
+static const char MOVE_FACE_NAMES[] = "URFDLBXYZ";
+
+std::string moveToString(Move m) {
+    std::string text(1, MOVE_FACE_NAMES[moveFace(m)]);
+    if (movePower(m) == 2) text += '2';
+    else if (movePower(m) == 3) text += '\'';
+    return text;
+}
+
+bool moveFromString(const std::string& text, Move& m) {
+    if (text.empty() || text.size() > 2) return false;
+
+    int face = -1;
+    for (int f = 0; f < 9; f++) {
+        if (text[0] == MOVE_FACE_NAMES[f]) face = f;
+    }
+    if (face == -1) return false;
+
+    int power = 1;
+    if (text.size() == 2) {
+        if (text[1] == '2') power = 2;
+        else if (text[1] == '\'') power = 3;
+        else return false;
+    }
+    m = makeMove(face, power);
+    return true;
+}
+
+bool parseAlgorithm(const std::string& text, std::vector<Move>& moves, std::string& badToken) {
+    moves.clear();
+    std::istringstream in(text);
+    std::string token;
+    Move m;
+    while (in >> token) {
+        if (!moveFromString(token, m)) {
+            badToken = token;
+            return false;
+        }
+        moves.push_back(m);
+    }
+    return true;
+}
+
+std::string algorithmToString(const std::vector<Move>& moves) {
+    std::string text;
+    for (Move m : moves) {
+        if (!text.empty()) text += ' ';
+        text += moveToString(m);
+    }
+    return text;
+}
@@ -0,0 +1,45 @@
+#ifndef CUBECORE_MOVE_H
+#define CUBECORE_MOVE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Face turns and middle slices in RubiksCube::executeMove notation.
+// U1 is "U", U2 is a half turn and U3 is "U'". X, Y and Z turn the middle
+// layer in the same direction as R, U and F respectively.
+enum Move : uint8_t {
+    U1, U2, U3, R1, R2, R3, F1, F2, F3,
+    D1, D2, D3, L1, L2, L3, B1, B2, B3,
+    X1, X2, X3, Y1, Y2, Y3, Z1, Z2, Z3
+};
+
+constexpr int FACE_MOVE_COUNT = 18; // U..B, the moves solvers search over
+constexpr int MOVE_COUNT = 27;      // Face moves plus the three slices
+
+// 0..5 for U R F D L B, 6..8 for the X Y Z slices
+constexpr int moveFace(Move m) { return m / 3; }
+// Quarter turns in the move (1, 2 or 3)
+constexpr int movePower(Move m) { return m % 3 + 1; }
+constexpr Move makeMove(int face, int power) { return Move(face * 3 + power - 1); }
+constexpr Move inverseMove(Move m) { return makeMove(moveFace(m), 4 - movePower(m)); }
+
+// Search pruning for face moves: m after previous is redundant when both turn
+// the same face, or opposite faces in the order D U, L R, B F (the other
+// order reaches the same state)
+constexpr bool isRedundantAfter(Move previous, Move m) {
+    int face = moveFace(m), last = moveFace(previous);
+    return face == last || face == last - 3;
+}
+
+std::string moveToString(Move m);
+// Accepts "R", "R2" and "R'"; returns false for anything else
+bool moveFromString(const std::string& text, Move& m);
+
+// Parses a space separated algorithm such as "R U R' U'". False at the first
+// token that is not a move, which goes to badToken; moves holds the whole
+// algorithm otherwise
+bool parseAlgorithm(const std::string& text, std::vector<Move>& moves, std::string& badToken);
+std::string algorithmToString(const std::vector<Move>& moves);
+
+#endif // CUBECORE_MOVE_H
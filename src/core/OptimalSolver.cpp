@@ -0,0 +1,311 @@
+#include "OptimalSolver.h"
+#include "Coordinates.h"
+#include "CubeAlgebra.h"
+#include "Symmetry.h"
+#include "TableGenerator.h"
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string>
+
+// --- Pattern databases ---
+
+TableFileInfo patternDatabaseInfo(const std::string& name) {
+    TableFileInfo info;
+    info.generator = "OptimalSolver breadth-first";
+    info.bitsPerEntry = 2;
+    info.moveCount = FACE_MOVE_COUNT;
+    if (name == "corners") {
+        info.coordinate = "cornerPerm * 2187 + twist";
+        info.states = CORNER_PATTERN_COUNT;
+        info.goal = 0;
+    } else {
+        int firstEdge = name == "edgesA" ? 0 : EDGE_GROUP_SIZE;
+        uint8_t solved[EDGE_GROUP_SIZE];
+        for (int i = 0; i < EDGE_GROUP_SIZE; i++) solved[i] = (firstEdge + i) * 2;
+        info.coordinate = "edge group " + std::to_string(firstEdge) + ".." +
+                          std::to_string(firstEdge + EDGE_GROUP_SIZE - 1) + ", slot * 2 + flip";
+        info.states = EDGE_PATTERN_COUNT;
+        info.goal = rankEdgeGroup(solved, EDGE_GROUP_SIZE);
+    }
+    return info;
+}
+
+// Fills table by breadth-first search on all hardware threads and writes
+// it to path for the next start. The generator's threads are only started
+// once a table has to be generated. False, with nothing written, when
+// cancel stops it.
+template <class Next>
+static bool generateDatabase(Mod3PruningTable& table, const TableFileInfo& info, const std::string& path,
+                             std::unique_ptr<TableGenerator>& generator, Next next,
+                             const std::atomic<bool>* cancel) {
+    if (!generator) generator = std::make_unique<TableGenerator>();
+    if (!generator->generate(table, info.goal, info.moveCount, next, cancel)) return false;
+    writeTableFile(path, info, table.raw());
+    return true;
+}
+
+// The database from the host's shared segment when shared tables are on,
+// else from its table file if there is a valid one, else generated. A
+// shared segment is filled the same way by whichever process comes first.
+// False when cancel stops the generation.
+template <class Next>
+static bool loadDatabase(const std::string& name, Mod3PruningTable& table, std::unique_ptr<TableGenerator>& generator,
+                         Next next, const std::atomic<bool>* cancel) {
+    TableFileInfo info = patternDatabaseInfo(name);
+    std::string path = tableDirectory() + "/" + name + ".tbl";
+
+    if (useSharedTables()) {
+        std::shared_ptr<uint8_t[]> entries = sharedTable(name, info, [&](uint8_t* segment) {
+            size_t bytes = tableFileBytes(info);
+            if (std::shared_ptr<uint8_t[]> file = mapTableFile(path, info)) {
+                std::memcpy(segment, file.get(), bytes);
+                return true;
+            }
+            // Generated in place; the segment outlives this table
+            std::memset(segment, 0xff, bytes);
+            Mod3PruningTable shared(info.states, std::shared_ptr<uint8_t[]>(segment, [](uint8_t*) {}));
+            return generateDatabase(shared, info, path, generator, next, cancel);
+        });
+        if (entries) {
+            table = Mod3PruningTable(info.states, entries);
+            return true;
+        }
+        if (cancel && *cancel) return false;
+    }
+
+    if (std::shared_ptr<uint8_t[]> entries = mapTableFile(path, info)) {
+        if (!useHugePages()) {
+            table = Mod3PruningTable(info.states, entries);
+            return true;
+        }
+        // File pages cannot be huge; a private copy can
+        std::shared_ptr<uint8_t[]> copy = newTableBytes(tableFileBytes(info));
+        std::memcpy(copy.get(), entries.get(), tableFileBytes(info));
+        table = Mod3PruningTable(info.states, copy);
+        return true;
+    }
+    table = Mod3PruningTable(info.states);
+    return generateDatabase(table, info, path, generator, next, cancel);
+}
+
+static size_t cornerMove(size_t index, int m) {
+    const CoordinateTables& t = coordinateTables();
+    size_t perm = index / TWIST_COUNT, twist = index % TWIST_COUNT;
+    return t.cornerPermMove[perm][m] * (size_t)TWIST_COUNT + t.twistMove[twist][m];
+}
+
+static size_t edgeGroupMove(size_t index, int m) {
+    uint8_t states[EDGE_GROUP_SIZE];
+    unrankEdgeGroup(index, states, EDGE_GROUP_SIZE);
+    for (uint8_t& s : states) s = EDGE_STATE_MOVES[s][m];
+    return rankEdgeGroup(states, EDGE_GROUP_SIZE);
+}
+
+static std::unique_ptr<PatternDatabases> buildDatabases(const std::atomic<bool>* cancel) {
+    auto databases = std::make_unique<PatternDatabases>();
+    std::unique_ptr<TableGenerator> generator;
+    if (!loadDatabase("corners", databases->corners, generator, cornerMove, cancel) ||
+        !loadDatabase("edgesA", databases->edgesA, generator, edgeGroupMove, cancel) ||
+        !loadDatabase("edgesB", databases->edgesB, generator, edgeGroupMove, cancel)) {
+        return nullptr;
+    }
+    return databases;
+}
+
+const PatternDatabases* patternDatabases(const std::atomic<bool>* cancel) {
+    static std::mutex mutex;
+    static std::unique_ptr<PatternDatabases> databases;
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!databases) databases = buildDatabases(cancel);
+    return databases.get();
+}
+
+const PatternDatabases& patternDatabases() {
+    return *patternDatabases(nullptr);
+}
+
+// --- Solver ---
+
+OptimalSolver::OptimalSolver(OptimalOptions options)
+    : options(options), databases(patternDatabases()), pool(std::make_unique<WorkStealingPool>(options.threads)) {}
+
+OptimalResult OptimalSolver::solve(const CubieCube& cube) {
+    startTime = std::chrono::steady_clock::now();
+    result = OptimalResult();
+    stopped = false;
+
+    int rotation = centerRotation(cube);
+    CubieCube start = cube;
+    if (rotation != 0) start.multiply(symmetryTables().cubes[rotation]);
+
+    if (isSolvable(start)) {
+        Node root;
+        root.cornerPerm = rankCornerPerm(start);
+        root.twist = rankTwist(start);
+        for (int i = 0; i < EDGE_COUNT; i++) root.edges[start.ep[i]] = i * 2 + start.eo[i];
+
+        // The estimate is a bound already; every depth searched through
+        // without a solution proves the next one
+        result.lowerBound = estimate(root);
+        for (int depth = result.lowerBound; depth <= options.maxDepth && !stopped; depth++) {
+            if (searchBound(root, depth)) {
+                result.solved = true;
+                break;
+            }
+            if (!stopped) result.lowerBound = depth + 1;
+        }
+    }
+    result.stopped = stopped && !result.solved;
+
+    if (rotation != 0) {
+        const SymmetryTables& sym = symmetryTables();
+        for (Move& m : result.moves) m = sym.moveConjugate[sym.inverse[rotation]][m];
+    }
+    result.milliseconds = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - startTime).count();
+    return result;
+}
+
+// The databases only hold distances mod 3, so the root's are counted by
+// walking each table to its goal. Below the root every node's follow from
+// its parent's (see expand).
+int OptimalSolver::estimate(Node& node) {
+    result.lookups += 3;
+    node.cornerDistance = (uint8_t)databases.corners.distance(
+        node.cornerPerm * (size_t)TWIST_COUNT + node.twist, FACE_MOVE_COUNT, cornerMove);
+    node.edgesADistance = (uint8_t)databases.edgesA.distance(
+        rankEdgeGroup(&node.edges[0], EDGE_GROUP_SIZE), FACE_MOVE_COUNT, edgeGroupMove);
+    node.edgesBDistance = (uint8_t)databases.edgesB.distance(
+        rankEdgeGroup(&node.edges[EDGE_GROUP_SIZE], EDGE_GROUP_SIZE), FACE_MOVE_COUNT, edgeGroupMove);
+    return std::max<int>(node.cornerDistance, std::max(node.edgesADistance, node.edgesBDistance));
+}
+
+bool OptimalSolver::timeUp() {
+    if (options.cancel && *options.cancel) stopped = true;
+    if (options.timeLimitMs > 0 && std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - startTime).count() > options.timeLimitMs) {
+        stopped = true;
+    }
+    return stopped;
+}
+
+// One iteration of IDA*: serial while the bound is shallow, otherwise the
+// subtrees below splitDepth moves go to the pool
+bool OptimalSolver::searchBound(const Node& root, int depth) {
+    found = false;
+    if (pool->size() == 1 || depth <= options.splitDepth) {
+        Worker worker;
+        bool solved = search(root, depth, worker);
+        result.nodes += worker.nodes;
+        result.lookups += worker.lookups;
+        if (solved) result.moves = worker.path;
+        return solved;
+    }
+
+    std::vector<Subtree> subtrees;
+    std::vector<Move> path;
+    split(root, depth, options.splitDepth, path, subtrees);
+    pool->run(subtrees.size(), [&](size_t i) {
+        // Most subtrees are too small to reach the clock check in search()
+        if (found || stopped || timeUp()) return;
+        Worker worker;
+        worker.path = subtrees[i].path;
+        bool solved = search(subtrees[i].node, depth - options.splitDepth, worker);
+
+        std::lock_guard<std::mutex> lock(resultMutex);
+        result.nodes += worker.nodes;
+        result.lookups += worker.lookups;
+        if (solved && !found) {
+            found = true;
+            result.moves = worker.path;
+        }
+    });
+    return found;
+}
+
+// Child of node under m and its database indices, whose entries are
+// prefetched. Working out every child before looking any up lets the
+// lookups, mostly cache misses once the tables outgrow the cache, overlap
+// instead of each waiting for the last.
+void OptimalSolver::successor(const Node& node, Move m, Successor& child) const {
+    const CoordinateTables& t = coordinateTables();
+    child.move = m;
+    child.node.cornerPerm = t.cornerPermMove[node.cornerPerm][m];
+    child.node.twist = t.twistMove[node.twist][m];
+    for (int e = 0; e < EDGE_COUNT; e++) child.node.edges[e] = EDGE_STATE_MOVES[node.edges[e]][m];
+
+    child.cornerIndex = child.node.cornerPerm * (uint32_t)TWIST_COUNT + child.node.twist;
+    child.edgesAIndex = rankEdgeGroup(&child.node.edges[0], EDGE_GROUP_SIZE);
+    child.edgesBIndex = rankEdgeGroup(&child.node.edges[EDGE_GROUP_SIZE], EDGE_GROUP_SIZE);
+    databases.corners.prefetch(child.cornerIndex);
+    databases.edgesA.prefetch(child.edgesAIndex);
+    databases.edgesB.prefetch(child.edgesBIndex);
+}
+
+// Whether child may reach the goal in the depth - 1 moves left, as far as
+// the databases can tell. A move changes each distance by at most one, so
+// the child's exact distances follow from the node's and the mod 3
+// entries. Stop reading databases once one prunes.
+bool OptimalSolver::admissible(const Node& node, Successor& child, int depth, long& lookups) const {
+    lookups++;
+    child.node.cornerDistance = (uint8_t)databases.corners.neighborDistance(node.cornerDistance, child.cornerIndex);
+    if (child.node.cornerDistance > depth - 1) return false;
+    lookups++;
+    child.node.edgesADistance = (uint8_t)databases.edgesA.neighborDistance(node.edgesADistance, child.edgesAIndex);
+    if (child.node.edgesADistance > depth - 1) return false;
+    lookups++;
+    child.node.edgesBDistance = (uint8_t)databases.edgesB.neighborDistance(node.edgesBDistance, child.edgesBIndex);
+    return child.node.edgesBDistance <= depth - 1;
+}
+
+void OptimalSolver::split(const Node& node, int depth, int splitDepth, std::vector<Move>& path,
+                          std::vector<Subtree>& subtrees) {
+    if (splitDepth == 0) {
+        subtrees.push_back({node, path});
+        return;
+    }
+    for (int i = 0; i < FACE_MOVE_COUNT; i++) {
+        Move m = Move(i);
+        if (!path.empty() && isRedundantAfter(path.back(), m)) continue;
+        Successor child;
+        successor(node, m, child);
+        if (!admissible(node, child, depth, result.lookups)) continue;
+        result.nodes++;
+        path.push_back(m);
+        split(child.node, depth - 1, splitDepth - 1, path, subtrees);
+        path.pop_back();
+    }
+}
+
+bool OptimalSolver::search(const Node& node, int depth, Worker& worker) {
+    if (depth == 0) {
+        if (node.cornerPerm != 0 || node.twist != 0) return false;
+        for (int i = 0; i < EDGE_COUNT; i++) {
+            if (node.edges[i] != i * 2) return false;
+        }
+        return true;
+    }
+
+    Successor children[FACE_MOVE_COUNT];
+    int count = 0;
+    for (int i = 0; i < FACE_MOVE_COUNT; i++) {
+        Move m = Move(i);
+        if (!worker.path.empty() && isRedundantAfter(worker.path.back(), m)) continue;
+        successor(node, m, children[count++]);
+    }
+
+    for (int i = 0; i < count; i++) {
+        Successor& child = children[i];
+        if (!admissible(node, child, depth, worker.lookups)) continue;
+
+        if ((++worker.nodes & 0xfffff) == 0) timeUp();
+        // Another worker may have finished the iteration already
+        if (stopped || found) return false;
+
+        worker.path.push_back(child.move);
+        if (search(child.node, depth - 1, worker)) return true;
+        worker.path.pop_back();
+    }
+    return false;
+}
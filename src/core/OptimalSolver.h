@@ -0,0 +1,137 @@
+#ifndef CUBECORE_OPTIMALSOLVER_H
+#define CUBECORE_OPTIMALSOLVER_H
+
+#include "CubieCube.h"
+#include "Move.h"
+#include "PruningTable.h"
+#include "TableFile.h"
+#include "WorkStealingPool.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Korf's optimal solver: IDA* over the 18 face moves, guided by the largest
+// of three pattern databases (corners, and two disjoint sets of six edges).
+// Each database gives the exact distance of its pieces alone, so the
+// maximum never overestimates and the first solution found is a shortest one.
+//
+// Each iteration is cut into subtrees: the first splitDepth moves are
+// expanded up front, and the subtrees below them are searched in parallel
+// by a work-stealing pool. The first worker to reach the goal at the
+// current bound stops all the others.
+
+constexpr int CORNER_PATTERN_COUNT = 40320 * 2187;   // corner permutation x twist
+constexpr int EDGE_GROUP_SIZE = 6;
+constexpr int EDGE_PATTERN_COUNT = 665280 * 64;      // edgeGroupCount(6)
+
+// About 43 MB: distances mod 3, 2 bits per state, which the search turns
+// back into exact distances as it goes. Loaded on first use from table
+// files in tableDirectory() (corners.tbl, edgesA.tbl, edgesB.tbl, as
+// written by cube_tablegen), mapped and shared with any other process using
+// them. Missing or stale files are generated again on all hardware threads
+// (on the order of a minute on one) and written back, if the directory
+// exists. With $CUBE_SHARED_TABLES set, the solver processes on a host
+// attach to one shared memory copy instead (see sharedTable).
+struct PatternDatabases {
+    Mod3PruningTable corners;
+    Mod3PruningTable edgesA;  // edges UR..DF
+    Mod3PruningTable edgesB;  // edges DL..BR
+};
+
+const PatternDatabases& patternDatabases();
+// The same, but a build that *cancel stops returns null and is not kept; the
+// tables finished before it are kept as table files (where the table
+// directory exists), so a later call resumes from there
+const PatternDatabases* patternDatabases(const std::atomic<bool>* cancel);
+
+// Table file header of one database: "corners", "edgesA" or "edgesB"
+TableFileInfo patternDatabaseInfo(const std::string& name);
+
+struct OptimalOptions {
+    int maxDepth = 20;        // God's number; no position needs more
+    double timeLimitMs = 0;   // 0 for no limit
+    int threads = 0;          // 0 for one per hardware thread
+    int splitDepth = 3;       // moves expanded before the subtrees are shared out
+    const std::atomic<bool>* cancel = nullptr;  // setting it stops the search like the time limit
+};
+
+struct OptimalResult {
+    std::vector<Move> moves;
+    bool solved = false;      // false when stopped, or when nothing is within maxDepth
+    bool stopped = false;     // the time limit or cancel ended the search unfinished
+    int lowerBound = 0;       // proven: no solution is shorter than this
+    long nodes = 0;
+    long lookups = 0;         // pattern database reads
+    double milliseconds = 0;
+
+    double nodesPerSecond() const { return milliseconds > 0 ? nodes * 1000.0 / milliseconds : 0; }
+};
+
+class OptimalSolver {
+public:
+    explicit OptimalSolver(OptimalOptions options = {});
+
+    // Shortest face-turn solution. Centers moved by slice turns are put back
+    // with a whole-cube rotation first, as in TwoPhaseSolver.
+    OptimalResult solve(const CubieCube& cube);
+
+    int getThreads() const { return pool->size(); }
+
+private:
+    // Search node: corner coordinates plus the slot * 2 + flip of every
+    // edge, and the exact distance in each database
+    struct Node {
+        uint16_t cornerPerm;
+        uint16_t twist;
+        std::array<uint8_t, EDGE_COUNT> edges;
+        uint8_t cornerDistance;
+        uint8_t edgesADistance;
+        uint8_t edgesBDistance;
+    };
+
+    // A child of the node being searched, with the database indices it
+    // looks up, all worked out before any lookup is made
+    struct Successor {
+        Node node;
+        Move move;
+        uint32_t cornerIndex;
+        uint32_t edgesAIndex;
+        uint32_t edgesBIndex;
+    };
+
+    // One subtree: the node after the first splitDepth moves, and those moves
+    struct Subtree {
+        Node node;
+        std::vector<Move> path;
+    };
+
+    // What one thread searching a subtree keeps to itself
+    struct Worker {
+        std::vector<Move> path;
+        long nodes = 0;
+        long lookups = 0;
+    };
+
+    OptimalOptions options;
+    const PatternDatabases& databases;
+    std::unique_ptr<WorkStealingPool> pool;
+    OptimalResult result;
+    std::mutex resultMutex;
+    std::atomic<bool> found{false};
+    std::atomic<bool> stopped{false};
+    std::chrono::steady_clock::time_point startTime;
+
+    int estimate(Node& node);
+    bool timeUp();
+    bool searchBound(const Node& root, int depth);
+    void successor(const Node& node, Move m, Successor& child) const;
+    bool admissible(const Node& node, Successor& child, int depth, long& lookups) const;
+    void split(const Node& node, int depth, int splitDepth, std::vector<Move>& path, std::vector<Subtree>& subtrees);
+    bool search(const Node& node, int depth, Worker& worker);
+};
+
+#endif // CUBECORE_OPTIMALSOLVER_H
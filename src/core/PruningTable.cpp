@@ -0,0 +1,38 @@
+#include "PruningTable.h"
+#include <cstdlib>
+#include <cstring>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+static constexpr size_t HUGE_PAGE_BYTES = 2 << 20;
+
+bool useHugePages() {
+    const char* huge = std::getenv("CUBE_HUGE_PAGES");
+    return huge && *huge && std::strcmp(huge, "0") != 0;
+}
+
+void adviseHugePages(void* data, size_t bytes) {
+#ifdef __linux__
+    madvise(data, bytes, MADV_HUGEPAGE);
+#else
+    (void)data;
+    (void)bytes;
+#endif
+}
+
+std::shared_ptr<uint8_t[]> newTableBytes(size_t bytes) {
+    std::shared_ptr<uint8_t[]> data;
+#ifdef __linux__
+    void* aligned = nullptr;
+    if (bytes >= HUGE_PAGE_BYTES && useHugePages() && posix_memalign(&aligned, HUGE_PAGE_BYTES, bytes) == 0) {
+        // Advised before the first write, so the pages are huge from the start
+        adviseHugePages(aligned, bytes);
+        data = std::shared_ptr<uint8_t[]>(static_cast<uint8_t*>(aligned), [](uint8_t* p) { std::free(p); });
+    }
+#endif
+    if (!data) data = std::shared_ptr<uint8_t[]>(new uint8_t[bytes]);
+    std::memset(data.get(), 0xff, bytes);
+    return data;
+}
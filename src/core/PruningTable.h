@@ -0,0 +1,200 @@
+#ifndef CUBECORE_PRUNINGTABLE_H
+#define CUBECORE_PRUNINGTABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#if defined(_MSC_VER)
+#include <xmmintrin.h>
+#endif
+
+// A fresh block of table entries, every bit set (all entries EMPTY). Tables
+// can also be built over a block owned by someone else, such as a mapped
+// table file (see TableFile.h); such tables are read-only.
+//
+// With useHugePages(), blocks of a huge page or more are aligned to 2 MB
+// and marked for transparent huge pages (Linux), so random lookups across
+// a large table need far fewer TLB entries.
+std::shared_ptr<uint8_t[]> newTableBytes(size_t bytes);
+
+// Asks for huge pages under memory about to be filled, where the system
+// supports them (anonymous and, if enabled, shared memory on Linux)
+void adviseHugePages(void* data, size_t bytes);
+
+// Whether large tables get huge pages: set $CUBE_HUGE_PAGES to 1
+bool useHugePages();
+
+// Exact distance to the goal for every index of a coordinate space, two
+// entries per byte. Searches use it as an admissible heuristic.
+class PruningTable {
+public:
+    static constexpr uint8_t EMPTY = 15; // not reached (yet)
+
+    PruningTable() = default;
+    explicit PruningTable(size_t size) : PruningTable(size, newTableBytes(bytesFor(size))) {}
+    // The entries of size states in data, bytesFor(size) bytes of them
+    PruningTable(size_t size, std::shared_ptr<uint8_t[]> data) : count(size), data(std::move(data)) {}
+
+    static size_t bytesFor(size_t size) { return (size + 1) / 2; }
+
+    size_t size() const { return count; }
+    size_t bytes() const { return bytesFor(count); }
+    // The packed entries, bytes() of them, e.g. for writing to a file
+    const uint8_t* raw() const { return data.get(); }
+
+    uint8_t get(size_t index) const { return (data[index >> 1] >> ((index & 1) * 4)) & 15; }
+    void set(size_t index, uint8_t depth) {
+        uint8_t& b = data[index >> 1];
+        int shift = (index & 1) * 4;
+        b = (b & ~(15 << shift)) | (depth << shift);
+    }
+
+    // Breadth-first search from the goal index. next(index, move) returns
+    // the neighbor of index under move, for move in [0, moveCount); the move
+    // set must be closed under inverses. Once more than half the table is
+    // filled, each depth is found backwards instead (an empty entry with a
+    // neighbor at the current depth is one further), which touches far fewer
+    // entries. Entries deeper than 14 are left EMPTY.
+    template <class Next>
+    void generate(size_t goal, int moveCount, Next next) {
+        set(goal, 0);
+        size_t filled = 1;
+        for (uint8_t depth = 0; filled < count && depth < 14; depth++) {
+            size_t before = filled;
+            bool backward = filled > count / 2;
+            for (size_t i = 0; i < count; i++) {
+                if (backward) {
+                    if (get(i) != EMPTY) continue;
+                    for (int m = 0; m < moveCount; m++) {
+                        if (get(next(i, m)) == depth) {
+                            set(i, depth + 1);
+                            filled++;
+                            break;
+                        }
+                    }
+                } else {
+                    if (get(i) != depth) continue;
+                    for (int m = 0; m < moveCount; m++) {
+                        size_t j = next(i, m);
+                        if (get(j) == EMPTY) {
+                            set(j, depth + 1);
+                            filled++;
+                        }
+                    }
+                }
+            }
+            if (filled == before) break;
+        }
+    }
+
+private:
+    size_t count = 0;
+    std::shared_ptr<uint8_t[]> data;
+};
+
+// Distance to the goal mod 3, four entries per byte. Neighbors are at most
+// one move apart in distance, so when the distance of one entry is known,
+// the value of a neighbor tells whether it is one move closer. Following
+// such neighbors reaches the goal without storing exact depths.
+class Mod3PruningTable {
+public:
+    static constexpr uint8_t EMPTY = 3;
+
+    Mod3PruningTable() = default;
+    explicit Mod3PruningTable(size_t size) : Mod3PruningTable(size, newTableBytes(bytesFor(size))) {}
+    // The entries of size states in data, bytesFor(size) bytes of them
+    Mod3PruningTable(size_t size, std::shared_ptr<uint8_t[]> data) : count(size), data(std::move(data)) {}
+
+    static size_t bytesFor(size_t size) { return (size + 3) / 4; }
+
+    size_t size() const { return count; }
+    size_t bytes() const { return bytesFor(count); }
+    // The packed entries, bytes() of them, e.g. for writing to a file
+    const uint8_t* raw() const { return data.get(); }
+
+    uint8_t get(size_t index) const { return (data[index >> 2] >> ((index & 3) * 2)) & 3; }
+    void set(size_t index, uint8_t value) {
+        uint8_t& b = data[index >> 2];
+        int shift = (index & 3) * 2;
+        b = (b & ~(3 << shift)) | (value << shift);
+    }
+
+    // Starts loading the entry of index into the cache, for a get() soon
+    void prefetch(size_t index) const {
+#if defined(_MSC_VER)
+        _mm_prefetch(reinterpret_cast<const char*>(&data[index >> 2]), _MM_HINT_T0);
+#else
+        __builtin_prefetch(&data[index >> 2]);
+#endif
+    }
+
+    // Exact distance of a neighbor of a state parentDistance moves from the
+    // goal: it is one closer, as far or one further, and the three have
+    // different values mod 3
+    int neighborDistance(int parentDistance, size_t index) const {
+        return parentDistance + (get(index) - parentDistance % 3 + 4) % 3 - 1;
+    }
+
+    // Exact distance of index, counted by stepping to a closer neighbor
+    // until there is none, at the goal. The table must be complete.
+    template <class Next>
+    int distance(size_t index, int moveCount, Next next) const {
+        int steps = 0;
+        for (bool stepped = true; stepped; ) {
+            uint8_t closer = (get(index) + 2) % 3;
+            stepped = false;
+            for (int m = 0; m < moveCount && !stepped; m++) {
+                size_t neighbor = next(index, m);
+                if (get(neighbor) == closer) {
+                    index = neighbor;
+                    steps++;
+                    stepped = true;
+                }
+            }
+        }
+        return steps;
+    }
+
+    // Breadth-first search as in PruningTable::generate. An entry holding
+    // depth % 3 may also be three moves shallower, but all of its neighbors
+    // are filled by then, so expanding it again does no harm.
+    template <class Next>
+    void generate(size_t goal, int moveCount, Next next) {
+        set(goal, 0);
+        size_t filled = 1;
+        for (int depth = 0; filled < count; depth++) {
+            size_t before = filled;
+            bool backward = filled > count / 2;
+            uint8_t current = depth % 3, following = (depth + 1) % 3;
+            for (size_t i = 0; i < count; i++) {
+                if (backward) {
+                    if (get(i) != EMPTY) continue;
+                    for (int m = 0; m < moveCount; m++) {
+                        if (get(next(i, m)) == current) {
+                            set(i, following);
+                            filled++;
+                            break;
+                        }
+                    }
+                } else {
+                    if (get(i) != current) continue;
+                    for (int m = 0; m < moveCount; m++) {
+                        size_t j = next(i, m);
+                        if (get(j) == EMPTY) {
+                            set(j, following);
+                            filled++;
+                        }
+                    }
+                }
+            }
+            if (filled == before) break;
+        }
+    }
+
+private:
+    size_t count = 0;
+    std::shared_ptr<uint8_t[]> data;
+};
+
+#endif // CUBECORE_PRUNINGTABLE_H
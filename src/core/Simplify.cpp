@@ -0,0 +1,125 @@
+#include "Simplify.h"
+#include "CubeAlgebra.h"
+#include <algorithm>
+
+// Layers of each axis (U-D, R-L, F-B) as faces: the turning face, the
+// slice that turns with it, and the opposite face. Turning all three by
+// k, k and -k quarter turns rotates the whole cube.
+static const int AXIS_LAYERS[3][3] = {{0, 7, 3}, {1, 6, 4}, {2, 8, 5}};
+
+static void moveLayer(Move m, int& axis, int& layer) {
+    for (axis = 0; axis < 3; axis++) {
+        for (layer = 0; layer < 3; layer++) {
+            if (AXIS_LAYERS[axis][layer] == moveFace(m)) return;
+        }
+    }
+}
+
+static CubieCube rotationCube(int axis, int power) {
+    const int* faces = AXIS_LAYERS[axis];
+    return sequenceCube({makeMove(faces[0], power), makeMove(faces[1], power), makeMove(faces[2], 4 - power)});
+}
+
+// Output under construction. The input so far equals moves followed by the
+// whole-cube rotation held; the last run of moves on one axis is kept in
+// canonical order (face, opposite face, slice), at most one move per layer.
+struct Simplifier {
+    std::vector<Move> moves;
+    CubieCube held;
+    bool absorbRotations;
+
+    void push(Move m) {
+        // The same turn as seen before the held rotation
+        CubieCube relabelled = conjugate(MOVE_CUBES[m], held);
+        for (int i = 0; i < MOVE_COUNT; i++) {
+            if (MOVE_CUBES[i] == relabelled) {
+                m = Move(i);
+                break;
+            }
+        }
+
+        int axis, layer;
+        moveLayer(m, axis, layer);
+        int power[3] = {0, 0, 0};
+        power[layer] = movePower(m);
+        while (!moves.empty()) {
+            int lastAxis, lastLayer;
+            moveLayer(moves.back(), lastAxis, lastLayer);
+            if (lastAxis != axis) break;
+            power[lastLayer] += movePower(moves.back());
+            moves.pop_back();
+        }
+
+        // Take out the rotation that leaves the fewest layers turning
+        int best = 0, bestCount = 4;
+        for (int k = 0; k < (absorbRotations ? 4 : 1); k++) {
+            int count = ((power[0] - k) % 4 != 0) + ((power[1] - k) % 4 != 0) + ((power[2] + k) % 4 != 0);
+            if (count < bestCount) {
+                best = k;
+                bestCount = count;
+            }
+        }
+        if (best != 0) held = compose(rotationCube(axis, best), held);
+        power[0] -= best;
+        power[1] -= best;
+        power[2] += best;
+
+        static const int ORDER[3] = {0, 2, 1};
+        for (int i : ORDER) {
+            int p = ((power[i] % 4) + 4) % 4;
+            if (p != 0) moves.push_back(makeMove(AXIS_LAYERS[axis][i], p));
+        }
+    }
+};
+
+// Shortest product of rotations about the three axes equal to target
+static bool spellRotation(const CubieCube& target, int length, const CubieCube& sofar,
+                          std::vector<CubieCube>& factors, std::vector<std::pair<int, int>>& spelling) {
+    if (length == 0) return sofar == target;
+    for (int axis = 0; axis < 3; axis++) {
+        for (int power = 1; power <= 3; power++) {
+            spelling.push_back({axis, power});
+            if (spellRotation(target, length - 1, compose(sofar, factors[axis * 3 + power - 1]), factors, spelling)) {
+                return true;
+            }
+            spelling.pop_back();
+        }
+    }
+    return false;
+}
+
+static std::vector<Move> simplifyPass(const std::vector<Move>& moves, bool absorbRotations, bool keepOrientation) {
+    Simplifier s{{}, CubieCube(), absorbRotations};
+    for (Move m : moves) s.push(m);
+    if (!keepOrientation || s.held.isSolved()) return s.moves;
+
+    std::vector<CubieCube> factors;
+    for (int axis = 0; axis < 3; axis++) {
+        for (int power = 1; power <= 3; power++) factors.push_back(rotationCube(axis, power));
+    }
+    std::vector<std::pair<int, int>> spelling;
+    for (int length = 1; length <= 3; length++) {
+        if (spellRotation(s.held, length, CubieCube(), factors, spelling)) break;
+    }
+
+    // Played after everything else, so nothing is relabelled any more
+    s.held = CubieCube();
+    s.absorbRotations = false;
+    for (const auto& [axis, power] : spelling) {
+        const int* faces = AXIS_LAYERS[axis];
+        s.push(makeMove(faces[0], power));
+        s.push(makeMove(faces[1], power));
+        s.push(makeMove(faces[2], 4 - power));
+    }
+    return s.moves;
+}
+
+std::vector<Move> simplifyMoves(const std::vector<Move>& moves, bool keepOrientation) {
+    std::vector<Move> merged = simplifyPass(moves, false, keepOrientation);
+    // Taking a rotation out turns an opposite face pair (R L') into a slice
+    // turn, so face turn input would come back with slice turns in it
+    bool slices = std::any_of(moves.begin(), moves.end(), [](Move m) { return m >= FACE_MOVE_COUNT; });
+    if (!slices) return merged;
+    std::vector<Move> absorbed = simplifyPass(moves, true, keepOrientation);
+    return absorbed.size() <= merged.size() ? absorbed : merged;
+}
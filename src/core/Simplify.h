@@ -0,0 +1,23 @@
+#ifndef CUBECORE_SIMPLIFY_H
+#define CUBECORE_SIMPLIFY_H
+
+#include "Move.h"
+#include <vector>
+
+// Post-processing for move sequences from any solver or algorithm:
+//   - turns of one layer merge (R R -> R2, R R' -> nothing)
+//   - turns on one axis commute, so R L R' also merges (-> L)
+//   - a whole-cube rotation spelled as layer turns (R X L', U2 Y2 D2) is
+//     taken out, and every later move is relabelled to the faces it turns
+//     once the cube is held the original way; only done when the input has
+//     slice turns, so face turns in (any solver's output) give face turns out
+// Counting half turns as one move, the result is never longer than the
+// input.
+
+// With keepOrientation the result reaches exactly the same CubieCube,
+// centers included; any rotation left over is put back as layer turns at
+// the end. Without it the result may leave the whole cube rotated, which is
+// all a solve needs.
+std::vector<Move> simplifyMoves(const std::vector<Move>& moves, bool keepOrientation = true);
+
+#endif // CUBECORE_SIMPLIFY_H
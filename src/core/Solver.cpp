@@ -3,6 +3,7 @@
 //
 
 #include "Solver.h"
+#include "Algorithm.h"
 #include <iostream>
 #include <cmath>
 #include <map>
@@ -18,7 +19,22 @@
  * 3. PLL - Last Corners
  *
  */
-Solver::Solver(RubiksCube *cube) : cube(cube) {
+
+// Last layer algorithms, played move by move through algorithmMoves
+// (core/Algorithm.h); checkedAlgorithm makes a typo a compile error.
+static constexpr std::string_view OLL_LINE = checkedAlgorithm("F' R' U' R U F");
+static constexpr std::string_view OLL_LINE_UNALIGNED = checkedAlgorithm("F' R' U R U' F");
+static constexpr std::string_view OLL_DOT = checkedAlgorithm("R' U R U' F U' U' F' U' F U' U' F'");
+
+static constexpr std::string_view CORNER_CYCLE_A = checkedAlgorithm("L U' R' U L' U' R U");
+static constexpr std::string_view CORNER_CYCLE_B = checkedAlgorithm("F U' B' U F' U' B U");
+static constexpr std::string_view CORNER_CYCLE_C = checkedAlgorithm("R U' L' U R' U' L U");
+static constexpr std::string_view CORNER_CYCLE_D = checkedAlgorithm("R' U L U' R U L' U'");
+
+static constexpr std::string_view ORIENT_RIGHT_LEFT = checkedAlgorithm("R' U U R U R' U R L U U L' U' L U' L'");
+static constexpr std::string_view ORIENT_LEFT_RIGHT = checkedAlgorithm("L U U L' U' L U' L' R' U U R U R' U R");
+static constexpr std::string_view ORIENT_BACK_FRONT = checkedAlgorithm("B' U' U' B U B' U B F U' U' F' U' F U' U' F'");
+Solver::Solver(const CubeState* cube) : cube(cube) {
     // Initialize all member variables
     currentState = IDLE;
     currentStep = 0;
@@ -36,17 +52,21 @@ Solver::Solver(RubiksCube *cube) : cube(cube) {
     debugFaceIndexOrder();
 }
 
-void Solver::solve(RubiksCube* cube) {
+void Solver::solve(const CubeState* cube) {
     if (!cube) return;
 
     this->cube = cube;
 
     if (currentState == SOLVING) {
-        std::cout << "Solver is already active" << std::endl;
+        log() << "Solver is already active" << std::endl;
         return;
     }
 
-    std::cout << "Starting auto-solve..." << std::endl;
+    log() << "Starting auto-solve..." << std::endl;
+    resetProgress();
+}
+
+void Solver::resetProgress() {
     currentState = SOLVING;
     currentStep = 0;
     currentTargetColor = 'B';
@@ -55,6 +75,67 @@ void Solver::solve(RubiksCube* cube) {
     moveCounter = 0;
 
     stuckCount.clear();
+    currentF2LSlot = 0;
+    cubeRotationDone = false;
+    orientationResetDone = false;
+    baseEdge = false;
+    fullySolved = false;
+}
+
+std::ostream& Solver::log() const {
+    return verbose ? std::cout : quiet;
+}
+
+std::vector<std::string> Solver::computeSolution(const CubeState& state) {
+    CubeState scratch = state;
+    const CubeState* live = cube;
+    cube = &scratch;
+    resetProgress();
+
+    // The steps narrate every decision; keep that for the live solve only
+    bool wasVerbose = verbose;
+    verbose = false;
+
+    // Same loop as the engine's live solve, minus the animation: each
+    // getNextMove() either turns the scratch cube or advances a step
+    // (the method turns the whole cube for F2L, so solved means up to rotation)
+    std::vector<std::string> moves;
+    std::map<uint64_t, int> visits;  // by state hash
+    int idle = 0;
+    for (int step = 0; step < MAX_STEPS && idle < MAX_IDLE_STEPS && currentState == SOLVING
+                       && !scratch.isSolvedUpToRotation(); step++) {
+        std::string move = getNextMove();
+        if (!move.empty() && scratch.applyMove(move)) {
+            moves.push_back(move);
+            idle = 0;
+            if (++visits[scratch.getHash()] > MAX_REVISITS) break;
+        } else {
+            idle++;
+        }
+    }
+
+    verbose = wasVerbose;
+    cube = live;
+    currentState = scratch.isSolvedUpToRotation() ? SOLVED : FAILED;
+    return moves;
+}
+
+std::array<glm::ivec3, 26> Solver::currentPositions() const {
+    std::array<glm::ivec3, 26> positions;
+    for (int id = 0; id < CubeState::PIECE_COUNT; id++) {
+        GridPos p = cube->getPiece(id).pos;
+        positions[id] = glm::ivec3(p.x, p.y, p.z);
+    }
+    return positions;
+}
+
+std::array<glm::ivec3, 26> Solver::solvedPositions() const {
+    std::array<glm::ivec3, 26> positions;
+    for (int id = 0; id < CubeState::PIECE_COUNT; id++) {
+        GridPos p = cube->getSolvedPosition(id);
+        positions[id] = glm::ivec3(p.x, p.y, p.z);
+    }
+    return positions;
 }
 
 std::string Solver::getNextMove() {
@@ -74,34 +155,34 @@ std::string Solver::getNextMove() {
     if (!currentMoves.empty()) {
         std::string nextMove = currentMoves.front();
         currentMoves.erase(currentMoves.begin());
-        std::cout << "Executing queued move: " << nextMove << std::endl;
+        log() << "Executing queued move: " << nextMove << std::endl;
         return nextMove;
     }
 
     // Generate next set of moves based on current cube state
     if (!cube) {
-        std::cout << "ERROR: Cube is null!" << std::endl;
+        log() << "ERROR: Cube is null!" << std::endl;
         currentState = FAILED;
         return "";
     }
 
-    const auto& current = cube->getCurrentPosition();
-    const auto& solved = cube->getSolvedPosition();
+    const auto& current = currentPositions();
+    const auto& solved = solvedPositions();
 
     // ====== WHITE CROSS (Step 0) ======
     if (currentStep == 0) {
         // Try to solve the current target edge
-        currentMoves = solveSingleWhiteEdge(currentTargetColor, current, solved, cube);
+        currentMoves = solveSingleWhiteEdge(currentTargetColor, current, solved);
 
         if (!currentMoves.empty()) {
             std::string nextMove = currentMoves.front();
             currentMoves.erase(currentMoves.begin());
-            std::cout << "Solving W-" << currentTargetColor << " edge, next move: " << nextMove << std::endl;
+            log() << "Solving W-" << currentTargetColor << " edge, next move: " << nextMove << std::endl;
             return nextMove;
         }
 
         // Current edge is solved, check if we need to verify all edges
-        std::cout << "W-" << currentTargetColor << " edge solved, moving to next." << std::endl;
+        log() << "W-" << currentTargetColor << " edge solved, moving to next." << std::endl;
 
         if (currentTargetColor == 'B') {
             currentTargetColor = 'R';
@@ -117,9 +198,9 @@ std::string Solver::getNextMove() {
             bool allSolved = true;
             for (char color : {'B', 'R', 'G', 'O'}) {
                 int pieceID = findWhiteEdge(color, solved);
-                if (pieceID == -1 || !isEdgeSolved(pieceID, current, solved, cube)) {
+                if (pieceID == -1 || !isEdgeSolved(pieceID, current, solved)) {
                     allSolved = false;
-                    std::cout << "W-" << color << " edge was disturbed, re-solving..." << std::endl;
+                    log() << "W-" << color << " edge was disturbed, re-solving..." << std::endl;
                     currentTargetColor = color;
                     break;
                 }
@@ -131,51 +212,51 @@ std::string Solver::getNextMove() {
                 for (char color : {'B', 'R', 'G', 'O'}) {
                     int pieceID = findWhiteEdge(color, solved);
                     glm::ivec3 pos = current[pieceID];
-                    Cubelet* piece = cube->getCubelet(pos);
+                    const CubePiece* piece = pieceAt(pos);
                     if (!piece || getFaceColor(piece, UP) != 'W') {
                         visuallySolved = false;
-                        std::cout << "FINAL CHECK FAILED: W-" << color << " not solved! Restarting white cross..." << std::endl;
+                        log() << "FINAL CHECK FAILED: W-" << color << " not solved! Restarting white cross..." << std::endl;
                         currentTargetColor = 'B';  // Start over from first edge
                         break;
                     }
                 }
 
                 if (visuallySolved) {
-                    std::cout << "==================================" << std::endl;
-                    std::cout << "WHITE CROSS COMPLETE!" << std::endl;
-                    std::cout << "==================================" << std::endl;
+                    log() << "==================================" << std::endl;
+                    log() << "WHITE CROSS COMPLETE!" << std::endl;
+                    log() << "==================================" << std::endl;
                     currentStep = 1;  // Move to F2L
                     currentF2LSlot = 0;
-                    std::cout << "Starting F2L..." << std::endl;
+                    log() << "Starting F2L..." << std::endl;
                     return "";  // Return empty to trigger next step on next call
                 } else {
-                    std::cout << "White cross verification failed, restarting from W-B..." << std::endl;
+                    log() << "White cross verification failed, restarting from W-B..." << std::endl;
                     currentTargetColor = 'B';  // Start over
                     currentMoves.clear();  // Clear any queued moves
                 }
             }
         }
 
-        std::cout << "Moving to next edge W-" << currentTargetColor << std::endl;
+        log() << "Moving to next edge W-" << currentTargetColor << std::endl;
         return "";
     }
 
     // ====== F2L (Step 1) ======
     if (currentStep == 1) {
         // F2L Solving Phase
-        std::cout << "\n=== F2L STEP ===" << std::endl;
+        log() << "\n=== F2L STEP ===" << std::endl;
 
         // If we have moves queued, execute them
         if (!currentMoves.empty()) {
             std::string nextMove = currentMoves.front();
             currentMoves.erase(currentMoves.begin());
-            std::cout << "Executing: " << nextMove << std::endl;
+            log() << "Executing: " << nextMove << std::endl;
             return nextMove;
         }
 
         // First: Rotate cube for better view
         if (!cubeRotationDone) {
-            std::cout << "Rotating cube for F2L view..." << std::endl;
+            log() << "Rotating cube for F2L view..." << std::endl;
             currentMoves = {"R", "X", "L'","R", "X", "L'"};
             cubeRotationDone = true;
             debugFaceIndexOrder();
@@ -184,9 +265,9 @@ std::string Solver::getNextMove() {
 
         // Check if all F2L slots are solved
         if (currentF2LSlot >= 4) {
-            std::cout << "\n==================================" << std::endl;
-            std::cout << " F2L COMPLETE! " << std::endl;
-            std::cout << "==================================" << std::endl;
+            log() << "\n==================================" << std::endl;
+            log() << " F2L COMPLETE! " << std::endl;
+            log() << "==================================" << std::endl;
             currentStep = 2; // Move to next phase
             return "";
         }
@@ -195,7 +276,7 @@ std::string Solver::getNextMove() {
         std::vector<F2LPair> allPairs = getF2LPairs();
 
         if (currentF2LSlot >= allPairs.size()) {
-            std::cout << "ERROR: F2L slot out of range" << std::endl;
+            log() << "ERROR: F2L slot out of range" << std::endl;
             currentState = FAILED;
             return "";
         }
@@ -207,34 +288,34 @@ std::string Solver::getNextMove() {
         targetPair.edgeID = findF2LEdge(targetPair.color1, targetPair.color2);
 
         if (targetPair.cornerID == 1 || targetPair.edgeID == 1) {
-            std:cout  << "ERROR: Could not find F2L pieces for slot " << currentF2LSlot << std::endl;
-            std::cout << "  Target pair: " << targetPair.color1 << "-" << targetPair.color2 << std::endl;
+            log()  << "ERROR: Could not find F2L pieces for slot " << currentF2LSlot << std::endl;
+            log() << "  Target pair: " << targetPair.color1 << "-" << targetPair.color2 << std::endl;
             currentState = FAILED;
             return "";
         }
 
         // Get current positions
-        const auto& posit = cube->getCurrentPosition();
+        const auto& posit = currentPositions();
         glm::ivec3 cornerPos = posit[targetPair.cornerID];
         glm::ivec3 edgePos = posit[targetPair.edgeID];
 
-        Cubelet* corner = cube->getCubelet(cornerPos);
-        Cubelet* edge = cube->getCubelet(edgePos);
+        const CubePiece* corner = pieceAt(cornerPos);
+        const CubePiece* edge = pieceAt(edgePos);
 
         if (!corner || !edge) {
-            std::cout << "ERROR: Could not get cubelet objects" << std::endl;
+            log() << "ERROR: Could not get cubelet objects" << std::endl;
             currentState = FAILED;
             return "";
         }
 
         // Debug info
-        std::cout << "\n--- F2L Slot " << currentF2LSlot + 1 << " ---" << std::endl;
-        std::cout << "Target: " << targetPair.color1 << "-" << targetPair.color2 << std::endl;
-        std::cout << "Corner at: (" << cornerPos.x << "," << cornerPos.y << "," << cornerPos.z << ")" << std::endl;
-        std::cout << "Edge at: (" << edgePos.x << "," << edgePos.y << "," << edgePos.z << ")" << std::endl;
+        log() << "\n--- F2L Slot " << currentF2LSlot + 1 << " ---" << std::endl;
+        log() << "Target: " << targetPair.color1 << "-" << targetPair.color2 << std::endl;
+        log() << "Corner at: (" << cornerPos.x << "," << cornerPos.y << "," << cornerPos.z << ")" << std::endl;
+        log() << "Edge at: (" << edgePos.x << "," << edgePos.y << "," << edgePos.z << ")" << std::endl;
 
         if (isF2LPairSolved(targetPair)) {
-            std::cout << "Slot Solved Moving to Next Slot..." << std::endl;
+            log() << "Slot Solved Moving to Next Slot..." << std::endl;
             currentF2LSlot++;
             return "U";
         }
@@ -247,7 +328,7 @@ std::string Solver::getNextMove() {
 
             // DOUBLE CHECK #2
             if (isF2LPairSolved(targetPair)) {
-                std::cout << "[DOUBLE CHECK] Pair solved after move generation. Clearing moves." << std::endl;
+                log() << "[DOUBLE CHECK] Pair solved after move generation. Clearing moves." << std::endl;
                 currentMoves.clear();
                 currentF2LSlot++;
                 return "U";
@@ -256,37 +337,37 @@ std::string Solver::getNextMove() {
             std::string firstMove = currentMoves.front();
             currentMoves.erase(currentMoves.begin());
 
-            std::cout << "Solving with: " << firstMove;
+            log() << "Solving with: " << firstMove;
             for (size_t i = 0; i < currentMoves.size(); i++) {
-                std::cout << " " << currentMoves[i];
+                log() << " " << currentMoves[i];
             }
-            std::cout << std::endl;
+            log() << std::endl;
 
             return firstMove;
         }
 
 
         // If no moves generated but not solved, rotate and try again
-        std::cout << "No solution found, rotating U..." << std::endl;
+        log() << "No solution found, rotating U..." << std::endl;
         return "";
     }
 
     // ====== OLL (Step 2) ======
     if (currentStep == 2) {
-        std::cout << "OLL Step" << std::endl;
+        log() << "OLL Step" << std::endl;
         currentMoves = solveOLLCross();
         if (!currentMoves.empty()) {
             std::string nextMove = currentMoves.front();
             currentMoves.erase(currentMoves.begin());
-            std::cout << "OLL Cross move: " << nextMove << std::endl;
+            log() << "OLL Cross move: " << nextMove << std::endl;
             return nextMove;
         }
 
         // OLL cross is complete, check if it's really solved
         if (detectOLLState() == CROSS_SHAPE) {
-            std::cout << "==================================\n";
-            std::cout << " OLL CROSS COMPLETE!\n";
-            std::cout << "==================================\n";
+            log() << "==================================\n";
+            log() << " OLL CROSS COMPLETE!\n";
+            log() << "==================================\n";
             currentStep = 3;  // Move to PLL (edge permutation)
             return "";
         }
@@ -300,12 +381,12 @@ std::string Solver::getNextMove() {
             orientationResetDone = true;
         }
 
-        std::cout << "=== PLL EDGE PERMUTATION ===" << std::endl;
+        log() << "=== PLL EDGE PERMUTATION ===" << std::endl;
 
         currentMoves = solveLastLayerEdges_Fixed();
 
         if (countAlignedEdges_Fixed() == 4) {
-            std::cout << "PLL EDGES COMPLETE!" << std::endl;
+            log() << "PLL EDGES COMPLETE!" << std::endl;
             currentStep = 4;
             return "";
         }
@@ -313,11 +394,11 @@ std::string Solver::getNextMove() {
 
     // STEP 4: PLL CORNERS
     if (currentStep == 4) {
-        std::cout << "=== PLL CORNER PERMUTATION ===" << std::endl;
+        log() << "=== PLL CORNER PERMUTATION ===" << std::endl;
         if (fullySolved) {
             currentMoves = {"R'", "X'", "L","R'", "X'", "L"};
 
-            std::cout << "CUBE SOLVED!" << std::endl;
+            log() << "CUBE SOLVED!" << std::endl;
             currentState = SOLVED;
             return "";
         }
@@ -328,24 +409,23 @@ std::string Solver::getNextMove() {
     return "";
 }
 
-char Solver::getFaceColor(const Cubelet* piece, Face face) const {
+char Solver::getFaceColor(const CubePiece* piece, Face face) const {
     if (!piece) {
         return '?';
     }
-    const color& c = piece->getFaceColor(face);
-    return colorToChar(c);
+    return piece->getFaceColor(face);
 }
 
 bool Solver::isWhiteCrossSolved() const {
-    const auto& current = cube->getCurrentPosition();
-    const auto& solved = cube->getSolvedPosition();
+    const auto& current = currentPositions();
+    const auto& solved = solvedPositions();
 
     for (char color : {'B', 'R', 'G', 'O'}) {
         int pieceID = findWhiteEdge(color, solved);
         if (pieceID == -1) return false;
 
         glm::ivec3 pos = current[pieceID];
-        Cubelet* piece = cube->getCubelet(pos);
+        const CubePiece* piece = pieceAt(pos);
         if (!piece) return false;
 
         // Check position AND orientation
@@ -355,15 +435,15 @@ bool Solver::isWhiteCrossSolved() const {
     return true;
 }
 bool Solver::isYellowCrossSolved() const {
-    const auto& current = cube->getCurrentPosition();
-    const auto& solved = cube->getSolvedPosition();
+    const auto& current = currentPositions();
+    const auto& solved = solvedPositions();
 
     for (char color : {'B', 'R', 'G', 'O'}) {
         int pieceID = findWhiteEdge(color, solved);
         if (pieceID == -1) return false;
 
         glm::ivec3 pos = current[pieceID];
-        Cubelet* piece = cube->getCubelet(pos);
+        const CubePiece* piece = pieceAt(pos);
         if (!piece) return false;
 
         // Check position AND orientation
@@ -373,38 +453,6 @@ bool Solver::isYellowCrossSolved() const {
     return true;
 }
 
-char Solver::colorToChar(const color &c) const {
-    // FIRST check if it's black (internal face)
-    if (c.red == 0.0f && c.green == 0.0f && c.blue == 0.0f) {
-        return '?';  // Internal face, no sticker
-    }
-
-    // Then check actual colors with tolerance
-    struct Named { color col; char ch; };
-    const std::vector<Named> palette = {
-        {{1.0f, 1.0f, 1.0f}, 'W'},
-        {{1.0f, 1.0f, 0.0f}, 'Y'},
-        {{0.0f, 0.0f, 1.0f}, 'B'},
-        {{0.0f, 0.5f, 0.0f}, 'G'},
-        {{1.0f, 0.0f, 0.0f}, 'R'},
-        {{1.0f, 0.5f, 0.0f}, 'O'}
-    };
-
-    float best = 1e9;
-    char bestCh = '?';
-
-    for (const auto &n : palette) {
-        float d = (c.red - n.col.red) * (c.red - n.col.red)
-                + (c.green - n.col.green) * (c.green - n.col.green)
-                + (c.blue - n.col.blue) * (c.blue - n.col.blue);
-        if (d < best) {
-            best = d;
-            bestCh = n.ch;
-        }
-    }
-    return bestCh;
-}
-
 int Solver::findWhiteEdge(char targetColor, const std::array<glm::ivec3, 26>& solved) const {
     // White edges are at positions with exactly one coordinate = 0 and Y = 1
     // Solved positions: (0,1,1)=W-B, (1,1,0)=W-R, (0,1,-1)=W-G, (-1,1,0)=W-O
@@ -427,10 +475,10 @@ int Solver::findWhiteEdge(char targetColor, const std::array<glm::ivec3, 26>& so
 
 // Check if an edge is solved
 bool Solver::isEdgeSolved(int pieceID, const std::array<glm::ivec3, 26>& current,
-                          const std::array<glm::ivec3, 26>& solved, RubiksCube* cubePtr) const {
+                          const std::array<glm::ivec3, 26>& solved) const {
     if (current[pieceID] != solved[pieceID]) return false;
 
-    Cubelet* piece = cubePtr->getCubelet(current[pieceID]);
+    const CubePiece* piece = pieceAt(current[pieceID]);
     if (!piece) return false;
 
     // Check if white is on top face
@@ -441,54 +489,43 @@ bool Solver::isEdgeSolved(int pieceID, const std::array<glm::ivec3, 26>& current
 
 std::vector<std::string> Solver::solveSingleWhiteEdge(char targetColor,
                                                      const std::array<glm::ivec3, 26>& current,
-                                                     const std::array<glm::ivec3, 26>& solved,
-                                                     RubiksCube* cubePtr) const {
+                                                     const std::array<glm::ivec3, 26>& solved) const {
     int pieceID = findWhiteEdge(targetColor, solved);
     if (pieceID == -1) {
-        std::cout << "ERROR: Could not find W-" << targetColor << " edge!" << std::endl;
+        log() << "ERROR: Could not find W-" << targetColor << " edge!" << std::endl;
         return {};
     }
 
     glm::ivec3 currentPos = current[pieceID];
-    Cubelet* piece = cubePtr->getCubelet(currentPos);
+    const CubePiece* piece = pieceAt(currentPos);
     if (!piece) {
-        std::cout << "ERROR: Could not get cubelet at position!" << std::endl;
+        log() << "ERROR: Could not get cubelet at position!" << std::endl;
         return {};
     }
 
     // Check if edge is already solved
-    if (isEdgeSolved(pieceID, current, solved, cubePtr)) {
-        std::cout << "W-" << targetColor << " edge already solved." << std::endl;
+    if (isEdgeSolved(pieceID, current, solved)) {
+        log() << "W-" << targetColor << " edge already solved." << std::endl;
         return {};
     }
 
-    int pid = findWhiteEdge(currentTargetColor, solved);
-    std::string key = "";
-    if (pid != -1) {
-        glm::ivec3 curp = current[pid];
-        Cubelet* p = cube->getCubelet(curp);
-        char wf = getWhiteFace(p);
-        key = std::string(1, currentTargetColor) + ":" +
-              std::to_string(curp.x) + "," + std::to_string(curp.y) + "," + std::to_string(curp.z) + ":" +
-              std::string(1, wf);
+    // Same cube state and target again means the edge moves are going round in circles
+    uint64_t key = cube->getHash() ^ (uint64_t)currentTargetColor;
+    int &c = stuckCount[key];
+    // Lowered threshold from 6 to 3 to catch 2-move loops faster
+    if (c++ > 3) {
+        log() << "DEBUG: detected stuck on state " << std::hex << key << std::dec
+                  << ", forcing fallback rotation D'" << std::endl;
+        stuckCount.clear();
+        return {"D'"}; // Use D' to break the "D-move" loop
     }
 
-    if (!key.empty()) {
-        int &c = stuckCount[key];
-        // Lowered threshold from 6 to 3 to catch 2-move loops faster
-        if (c++ > 3) {
-            std::cout << "DEBUG: detected stuck on " << key << ", forcing fallback rotation D'" << std::endl;
-            stuckCount.clear();
-            return {"D'"}; // Use D' to break the "D-move" loop
-        }
-    }
-
-    std::cout << "Processing W-" << targetColor << " edge at ("
+    log() << "Processing W-" << targetColor << " edge at ("
               << currentPos.x << "," << currentPos.y << "," << currentPos.z
               << "), white on " << getWhiteFace(piece) << " face" << std::endl;
 
     if (getWhiteFace(piece) == '?') {
-        std::cout << "ERROR: Cannot find white sticker!" << std::endl;
+        log() << "ERROR: Cannot find white sticker!" << std::endl;
         return {};
     }
 
@@ -500,7 +537,7 @@ std::vector<std::string> Solver::solveSingleWhiteEdge(char targetColor,
 
     // CASE 1: Edge is in correct position but FLIPPED (wrong orientation)
     if (currentPos == targetPos) {
-        std::cout << "W-" << targetColor << " is in correct position but white on " << getWhiteFace(piece) << " (should be on U)." << std::endl;
+        log() << "W-" << targetColor << " is in correct position but white on " << getWhiteFace(piece) << " (should be on U)." << std::endl;
         if (targetColor == 'B') return {"F"};
         else if (targetColor == 'R') return {"R"};
         else if (targetColor == 'G') return {"B"};
@@ -509,7 +546,7 @@ std::vector<std::string> Solver::solveSingleWhiteEdge(char targetColor,
 
     // CASE 2: Edge is in the WRONG top layer position
     if (currentPos.y == 1 && currentPos != targetPos) {
-        std::cout << "W-" << targetColor << " is in WRONG top layer position." << std::endl;
+        log() << "W-" << targetColor << " is in WRONG top layer position." << std::endl;
         if (currentPos.z == 1) return {"F"};
         if (currentPos.z == -1) return {"B", "B"};
         if (currentPos.x == 1) return {"R", "R"};
@@ -522,13 +559,13 @@ std::vector<std::string> Solver::solveSingleWhiteEdge(char targetColor,
         char whiteFace = getWhiteFace(piece);
 
         if (currentPos == targetBottom) {
-            std::cout << "W-" << targetColor << " is aligned under target position." << std::endl;
-            std::cout << "  Current position: (" << currentPos.x << "," << currentPos.y << "," << currentPos.z << ")" << std::endl;
-            std::cout << "  White on face: " << whiteFace << std::endl;
+            log() << "W-" << targetColor << " is aligned under target position." << std::endl;
+            log() << "  Current position: (" << currentPos.x << "," << currentPos.y << "," << currentPos.z << ")" << std::endl;
+            log() << "  White on face: " << whiteFace << std::endl;
 
             // CASE A: White facing DOWN - Perfect orientation, just insert
             if (whiteFace == 'D') {
-                std::cout << "White facing down - perfect orientation, inserting!" << std::endl;
+                log() << "White facing down - perfect orientation, inserting!" << std::endl;
                 if (targetColor == 'B') return {"F","F"};  // Edge at (0,-1,1)
                 if (targetColor == 'R') return {"R", "R"};  // Edge at (1,-1,0)
                 if (targetColor == 'G') return {"B", "B"};  // Edge at (0,-1,-1)
@@ -537,124 +574,124 @@ std::vector<std::string> Solver::solveSingleWhiteEdge(char targetColor,
 
  // CASE B: White facing RIGHT
         else if (whiteFace == 'R') {
-            std::cout << "White facing RIGHT" << std::endl;
+            log() << "White facing RIGHT" << std::endl;
 
             // Edge at (0,-1,1) - bottom front, white facing right
             if (currentPos.x == 0 && currentPos.z == 1) {
-                std::cout << "  Position: Bottom-Front, solving W-B edge" << std::endl;
+                log() << "  Position: Bottom-Front, solving W-B edge" << std::endl;
                 return {"R"};
             }
             // Edge at (1,-1,0) - bottom right, white facing right
             else if (currentPos.x == 1 && currentPos.z == 0) {
-                std::cout << "  Position: Bottom-Right, solving W-R edge" << std::endl;
+                log() << "  Position: Bottom-Right, solving W-R edge" << std::endl;
                 return {"R"};
             }
             // Edge at (0,-1,-1) - bottom back, white facing right
             else if (currentPos.x == 0 && currentPos.z == -1) {
-                std::cout << "  Position: Bottom-Back, solving W-G edge" << std::endl;
+                log() << "  Position: Bottom-Back, solving W-G edge" << std::endl;
                 return {"R"};
             }
             // Edge at (-1,-1,0) - bottom left, white facing right
             else if (currentPos.x == -1 && currentPos.z == 0) {
-                std::cout << "  Position: Bottom-Left, solving W-O edge" << std::endl;
+                log() << "  Position: Bottom-Left, solving W-O edge" << std::endl;
                 return {"R"};
             }
         }
 
             // CASE C: White facing BACK - Need to check WHERE edge is
         else if (whiteFace == 'B') {
-            std::cout << "White facing BACK" << std::endl;
+            log() << "White facing BACK" << std::endl;
 
             // Edge at (0,-1,1) - bottom front, white facing back
             if (currentPos.x == 0 && currentPos.z == 1) {
-                std::cout << "  Position: Bottom-Front, solving W-B edge" << std::endl;
+                log() << "  Position: Bottom-Front, solving W-B edge" << std::endl;
                 return {"D", "R", "D'", "R", "R"};
             }
             // Edge at (1,-1,0) - bottom right, white facing back
             else if (currentPos.x == 1 && currentPos.z == 0) {
-                std::cout << "  Position: Bottom-Right, solving W-R edge" << std::endl;
+                log() << "  Position: Bottom-Right, solving W-R edge" << std::endl;
                 return {"B", "D'", "B'", "D", "R", "R"};
             }
             // Edge at (0,-1,-1) - bottom back, white facing back
             else if (currentPos.x == 0 && currentPos.z == -1) {
-                std::cout << "  Position: Bottom-Back, solving W-G edge" << std::endl;
+                log() << "  Position: Bottom-Back, solving W-G edge" << std::endl;
                 return {"B", "D'", "B", "D"};
             }
             // Edge at (-1,-1,0) - bottom left, white facing back
             else if (currentPos.x == -1 && currentPos.z == 0) {
-                std::cout << "  Position: Bottom-Left, solving W-O edge" << std::endl;
+                log() << "  Position: Bottom-Left, solving W-O edge" << std::endl;
                 return {"B", "D", "B'", "D'", "L", "L"};
             }
         }
 
         // CASE D: White facing FRONT
         else if (whiteFace == 'F') {
-            std::cout << "White facing FRONT" << std::endl;
+            log() << "White facing FRONT" << std::endl;
 
             // Edge at (0,-1,1) - bottom front, white facing front (toward front)
             if (currentPos.x == 0 && currentPos.z == 1) {
-                std::cout << "  Position: Bottom-Front, solving W-B edge" << std::endl;
+                log() << "  Position: Bottom-Front, solving W-B edge" << std::endl;
                 // Instead of just F, we need to extract it properly to top layer
                 return {"F", "F"};
             }
             // Edge at (1,-1,0) - bottom right, white facing front
             else if (currentPos.x == 1 && currentPos.z == 0) {
-                std::cout << "  Position: Bottom-Right, solving W-R edge" << std::endl;
+                log() << "  Position: Bottom-Right, solving W-R edge" << std::endl;
                 return {"F", "D'", "F'", "D"};
             }
             // Edge at (0,-1,-1) - bottom back, white facing front (away from back)
             else if (currentPos.x == 0 && currentPos.z == -1) {
-                std::cout << "  Position: Bottom-Back, solving W-G edge" << std::endl;
+                log() << "  Position: Bottom-Back, solving W-G edge" << std::endl;
                 return {"F", "D'", "F'", "D"};
             }
             // Edge at (-1,-1,0) - bottom left, white facing front
             else if (currentPos.x == -1 && currentPos.z == 0) {
-                std::cout << "  Position: Bottom-Left, solving W-O edge" << std::endl;
+                log() << "  Position: Bottom-Left, solving W-O edge" << std::endl;
                 return {"F", "D'", "F'", "D"};
             }
         }
 
         // CASE E: White facing LEFT
         else if (whiteFace == 'L') {
-            std::cout << "White facing LEFT" << std::endl;
+            log() << "White facing LEFT" << std::endl;
 
             // Edge at (0,-1,1) - bottom front, white facing left
             if (currentPos.x == 0 && currentPos.z == 1) {
-                std::cout << "  Position: Bottom-Front, solving W-B edge" << std::endl;
+                log() << "  Position: Bottom-Front, solving W-B edge" << std::endl;
                 return {"L"};
             }
             // Edge at (1,-1,0) - bottom right, white facing left (toward center)
             else if (currentPos.x == 1 && currentPos.z == 0) {
-                std::cout << "  Position: Bottom-Right, solving W-R edge" << std::endl;
+                log() << "  Position: Bottom-Right, solving W-R edge" << std::endl;
                 return {"L"};
             }
             // Edge at (0,-1,-1) - bottom back, white facing left
             else if (currentPos.x == 0 && currentPos.z == -1) {
-                std::cout << "  Position: Bottom-Back, solving W-G edge" << std::endl;
+                log() << "  Position: Bottom-Back, solving W-G edge" << std::endl;
                 return {"L"};
             }
             // Edge at (-1,-1,0) - bottom left, white facing left (away from center)
             else if (currentPos.x == -1 && currentPos.z == 0) {
-                std::cout << "  Position: Bottom-Left, solving W-O edge" << std::endl;
+                log() << "  Position: Bottom-Left, solving W-O edge" << std::endl;
                 return {"L"};
             }
         }
 
         // CASE F: White facing UP
         else if (whiteFace == 'U') {
-            std::cout << "ERROR: White facing UP in bottom layer - moving to reorient" << std::endl;
+            log() << "ERROR: White facing UP in bottom layer - moving to reorient" << std::endl;
             return {"D"};
         }
 
         // FALLBACK: Unknown orientation
         else {
-            std::cout << "White facing unknown (" << whiteFace << "), rotating bottom..." << std::endl;
+            log() << "White facing unknown (" << whiteFace << "), rotating bottom..." << std::endl;
             return {"D"};
         }
     }
     // Edge not aligned
     else {
-        std::cout << "W-" << targetColor << " in bottom layer but not aligned. Rotating..." << std::endl;
+        log() << "W-" << targetColor << " in bottom layer but not aligned. Rotating..." << std::endl;
         return {"D"};
     }
 
@@ -662,77 +699,77 @@ std::vector<std::string> Solver::solveSingleWhiteEdge(char targetColor,
     }
 // CASE 4: Middle Layer
 if (currentPos.y == 0) {
-    std::cout << "=== MIDDLE LAYER EXTRACTION ===" << std::endl;
-    std::cout << "W-" << targetColor << " is in middle layer." << std::endl;
-    std::cout << "  Position: (" << currentPos.x << "," << currentPos.y << "," << currentPos.z << ")" << std::endl;
+    log() << "=== MIDDLE LAYER EXTRACTION ===" << std::endl;
+    log() << "W-" << targetColor << " is in middle layer." << std::endl;
+    log() << "  Position: (" << currentPos.x << "," << currentPos.y << "," << currentPos.z << ")" << std::endl;
 
     char whiteFace = getWhiteFace(piece);
-    std::cout << "  White facing: " << whiteFace << std::endl;
+    log() << "  White facing: " << whiteFace << std::endl;
 
     // Front-Right edge (1,0,1)
     if (currentPos.x == 1 && currentPos.z == 1) {
-        std::cout << "  Location: Front-Right edge (1,0,1)" << std::endl;
+        log() << "  Location: Front-Right edge (1,0,1)" << std::endl;
         if (whiteFace == 'F') {
-            std::cout << "  → Using R to extract (perpendicular to F)" << std::endl;
+            log() << "  → Using R to extract (perpendicular to F)" << std::endl;
             return {"R"};  // Use perpendicular move
         }
         else {
-            std::cout << "  → Using F to extract (perpendicular to R)" << std::endl;
+            log() << "  → Using F to extract (perpendicular to R)" << std::endl;
             return {"F"};  // Use perpendicular move
         }
     }
     // Front-Left edge (-1,0,1)
     else if (currentPos.x == -1 && currentPos.z == 1) {
-        std::cout << "  Location: Front-Left edge (-1,0,1)" << std::endl;
+        log() << "  Location: Front-Left edge (-1,0,1)" << std::endl;
         if (whiteFace == 'F') {
-            std::cout << "  → Using L to extract (perpendicular to F)" << std::endl;
+            log() << "  → Using L to extract (perpendicular to F)" << std::endl;
             return {"L"};  // Use perpendicular move
         }
         else {
-            std::cout << "  → Using F to extract (perpendicular to L)" << std::endl;
+            log() << "  → Using F to extract (perpendicular to L)" << std::endl;
             return {"F"};  // Use perpendicular move
         }
     }
     // Back-Right edge (1,0,-1)
     else if (currentPos.x == 1 && currentPos.z == -1) {
-        std::cout << "  Location: Back-Right edge (1,0,-1)" << std::endl;
+        log() << "  Location: Back-Right edge (1,0,-1)" << std::endl;
         if (whiteFace == 'B') {
-            std::cout << "  → Using R to extract (perpendicular to B)" << std::endl;
+            log() << "  → Using R to extract (perpendicular to B)" << std::endl;
             return {"R"};  // Use perpendicular move
         }
         else {
-            std::cout << "  → Using B to extract (perpendicular to R)" << std::endl;
+            log() << "  → Using B to extract (perpendicular to R)" << std::endl;
             return {"B"};  // Use perpendicular move
         }
     }
     // Back-Left edge (-1,0,-1)
     else if (currentPos.x == -1 && currentPos.z == -1) {
-        std::cout << "  Location: Back-Left edge (-1,0,-1)" << std::endl;
+        log() << "  Location: Back-Left edge (-1,0,-1)" << std::endl;
         if (whiteFace == 'B') {
-            std::cout << "  → Using L to extract (perpendicular to B)" << std::endl;
+            log() << "  → Using L to extract (perpendicular to B)" << std::endl;
             return {"L"};  // Use perpendicular move
         }
         else {
-            std::cout << "  → Using B to extract (perpendicular to L)" << std::endl;
+            log() << "  → Using B to extract (perpendicular to L)" << std::endl;
             return {"B"};  // Use perpendicular move
         }
     }
 
-    std::cout << "ERROR: Middle layer piece at unexpected position!" << std::endl;
-    std::cout << "  This shouldn't happen - edge should be at a corner of middle layer" << std::endl;
-    std::cout << "  Falling back to D rotation" << std::endl;
+    log() << "ERROR: Middle layer piece at unexpected position!" << std::endl;
+    log() << "  This shouldn't happen - edge should be at a corner of middle layer" << std::endl;
+    log() << "  Falling back to D rotation" << std::endl;
     return {"D"}; // Fallback
 }
 
 
     // Ultimate fallback
-    std::cout << "Using fallback rotation for W-" << targetColor << std::endl;
+    log() << "Using fallback rotation for W-" << targetColor << std::endl;
     return {"D'"};
 }
 
 
 
-char Solver::getWhiteFace(Cubelet* piece) const {
+char Solver::getWhiteFace(const CubePiece* piece) const {
     if (!piece) return '?';
 
     if (getFaceColor(piece, UP) == 'W')    return 'U';
@@ -775,7 +812,7 @@ std::vector<Solver::F2LPair> Solver::getF2LPairs() const {
 
 
 int Solver::findF2LCorner(char color1, char color2) const {
-    const auto& current = cube->getCurrentPosition();
+    const auto& current = currentPositions();
 
     for (int i = 0; i < 26; i++) {
         glm::ivec3 pos = current[i];
@@ -783,7 +820,7 @@ int Solver::findF2LCorner(char color1, char color2) const {
         // Corners are at positions with all coordinates = ±1
         if (std::abs(pos.x) == 1 && std::abs(pos.y) == 1 && std::abs(pos.z) == 1) {
             // This is a corner piece
-            Cubelet* piece = cube->getCubelet(pos);
+            const CubePiece* piece = pieceAt(pos);
             if (!piece) continue;
 
             // Check if this corner has white and the two target colors
@@ -809,7 +846,7 @@ int Solver::findF2LCorner(char color1, char color2) const {
 }
 
 int Solver::findF2LEdge(char color1, char color2) const {
-    const auto& current = cube->getCurrentPosition();
+    const auto& current = currentPositions();
 
     for (int i = 0; i < 26; i++) {
         glm::ivec3 pos = current[i];
@@ -829,7 +866,7 @@ int Solver::findF2LEdge(char color1, char color2) const {
 
         if (!isValidEdgePosition) continue;
 
-        Cubelet* piece = cube->getCubelet(pos);
+        const CubePiece* piece = pieceAt(pos);
         if (!piece) continue;
 
         bool hasColor1 = false;
@@ -857,30 +894,30 @@ int Solver::findF2LEdge(char color1, char color2) const {
 std::vector<std::string> Solver::solveF2LPair(const F2LPair& pair,
                                               glm::ivec3 cornerPos,
                                               glm::ivec3 edgePos,
-                                              Cubelet* corner,
-                                              Cubelet* edge) const {
+                                              const CubePiece* corner,
+                                              const CubePiece* edge) const {
 
-    std::cout << "=== EDGE PIECE ANALYSIS ===" << std::endl;
-    std::cout << "Looking for: " << pair.color1 << "-" << pair.color2 << " edge" << std::endl;
-    std::cout << "Found edge at: (" << edgePos.x << "," << edgePos.y << "," << edgePos.z << ")" << std::endl;
-    std::cout << "Edge colors:" << std::endl;
+    log() << "=== EDGE PIECE ANALYSIS ===" << std::endl;
+    log() << "Looking for: " << pair.color1 << "-" << pair.color2 << " edge" << std::endl;
+    log() << "Found edge at: (" << edgePos.x << "," << edgePos.y << "," << edgePos.z << ")" << std::endl;
+    log() << "Edge colors:" << std::endl;
     std::vector<Face> faces = {UP, DOWN, FRONT, BACK, RIGHT, LEFT};
     for (Face face : faces) {
         char color = getFaceColor(edge, face);
         if (color != '?') {
-            std::cout << "  Face " << face << ": " << color << std::endl;
+            log() << "  Face " << face << ": " << color << std::endl;
         }
     }
 
     // STEP 1: Extract corner if it's in a bottom slot (y == -1) (&& cornerPos != pair.targetCornerPos)
     if (cornerPos.y == -1 ) {
-        std::cout << "Corner in bottom slot - extracting to top..." << std::endl;
+        log() << "Corner in bottom slot - extracting to top..." << std::endl;
         return extractCornerFromSlot(cornerPos);
     }
 
     // STEP 2: Extract edge if it's in middle layer (y == 0) (&& edgePos != pair.targetEdgePos)
     if (edgePos.y == 0 ) {
-        std::cout << "Edge in middle layer - extracting to top..." << std::endl;
+        log() << "Edge in middle layer - extracting to top..." << std::endl;
         return extractEdgeFromMiddle(edgePos);
     }
 
@@ -890,19 +927,19 @@ std::vector<std::string> Solver::solveF2LPair(const F2LPair& pair,
         int targetX = 1;  // e.g., 1, -1, 1
         int targetZ = 1;  // e.g., 1, -1, -1, 1
 
-        std::cout << "Target slot X,Z: (" << targetX << ", " << targetZ << ")" << std::endl;
-        std::cout << "Corner currently at: (" << cornerPos.x << ", " << cornerPos.y << ", " << cornerPos.z << ")" << std::endl;
+        log() << "Target slot X,Z: (" << targetX << ", " << targetZ << ")" << std::endl;
+        log() << "Corner currently at: (" << cornerPos.x << ", " << cornerPos.y << ", " << cornerPos.z << ")" << std::endl;
 
         // Check if corner is above the target slot
         bool cornerAboveSlot = (cornerPos.x == targetX && cornerPos.z == targetZ);
 
         if (!cornerAboveSlot) {
-            std::cout << "Corner NOT above target slot - rotating U..." << std::endl;
+            log() << "Corner NOT above target slot - rotating U..." << std::endl;
             return {"U"};
         }
 
         // Corner is now above target slot
-        std::cout << "Corner positioned above target slot at ("
+        log() << "Corner positioned above target slot at ("
                   << cornerPos.x << "," << cornerPos.y << "," << cornerPos.z << ")" << std::endl;
 
         // insert the pair
@@ -914,7 +951,7 @@ std::vector<std::string> Solver::solveF2LPair(const F2LPair& pair,
 }
 
 std::vector<std::string> Solver::extractCornerFromSlot(glm::ivec3 pos) const {
-    std::cout << "Extracting corner from bottom slot at ("
+    log() << "Extracting corner from bottom slot at ("
               << pos.x << "," << pos.y << "," << pos.z << ")" << std::endl;
 
     if (pos.y == -1) {
@@ -929,7 +966,7 @@ std::vector<std::string> Solver::extractCornerFromSlot(glm::ivec3 pos) const {
 }
 
 std::vector<std::string> Solver::extractEdgeFromMiddle(glm::ivec3 pos) const {
-    std::cout << "Extracting edge from middle at ("
+    log() << "Extracting edge from middle at ("
               << pos.x << "," << pos.y << "," << pos.z << ")" << std::endl;
 
     if (pos.y == 0) {
@@ -943,8 +980,8 @@ std::vector<std::string> Solver::extractEdgeFromMiddle(glm::ivec3 pos) const {
     return {"U"};
 }
 
-std::vector<std::string> Solver::insertF2LPair(const F2LPair& pair, glm::ivec3 cornerPos, glm::ivec3 edgePos, Cubelet* corner, Cubelet* edge) const {
-    std::cout << "MADE IT TO THE INSERT FUNCTION" << std::endl;
+std::vector<std::string> Solver::insertF2LPair(const F2LPair& pair, glm::ivec3 cornerPos, glm::ivec3 edgePos, const CubePiece* corner, const CubePiece* edge) const {
+    log() << "MADE IT TO THE INSERT FUNCTION" << std::endl;
     Face whiteOnCorner = getColorFace(corner,'W');
     Face c1 = getColorFace(edge,pair.color1);
     Face c2 = getColorFace(edge,pair.color2);
@@ -953,68 +990,68 @@ std::vector<std::string> Solver::insertF2LPair(const F2LPair& pair, glm::ivec3 c
     auto isEdge = [&](Face a, Face b){
         return (c1 == a && c2 == b) || (c1 == b && c2 == a);
     };
-    cout << "\n=== F2L INSERT DEBUG ===\n";
-    cout << "White on corner: " << faceToString(whiteOnCorner) << "\n";
-    cout << "Edge faces: "
+    log() << "\n=== F2L INSERT DEBUG ===\n";
+    log() << "White on corner: " << faceToString(whiteOnCorner) << "\n";
+    log() << "Edge faces: "
          << faceToString(c1) << " (color1=" << pair.color1 << "), "
          << faceToString(c2) << " (color2=" << pair.color2 << ")\n";
-    cout << "CornerPos: (" << cornerPos.x << ", " << cornerPos.y << ", " << cornerPos.z << ")\n";
-    cout << "EdgePos:   (" << edgePos.x   << ", " << edgePos.y   << ", " << edgePos.z   << ")\n";
+    log() << "CornerPos: (" << cornerPos.x << ", " << cornerPos.y << ", " << cornerPos.z << ")\n";
+    log() << "EdgePos:   (" << edgePos.x   << ", " << edgePos.y   << ", " << edgePos.z   << ")\n";
 
     if (whiteOnCorner == RIGHT)
     {
         // color-specific variants when edge = UP+FRONT
         if (isEdge(UP, FRONT)) {
             if (pair.color1=='R' && pair.color2=='G') {
-                std::cout << "RLF2L 2 - RG" << std::endl;
+                log() << "RLF2L 2 - RG" << std::endl;
                 return {"U","F","U'","F'"};
             }
             if (pair.color1=='B' && pair.color2=='R') {
-                std::cout << "RLF2L 2 - BR" << std::endl;
+                log() << "RLF2L 2 - BR" << std::endl;
                 return {"U'","R","U","U","R'"};    
             }
             if (pair.color1=='G' && pair.color2=='O') {
-                std::cout << "RLF2L 2 - GO" << std::endl;
+                log() << "RLF2L 2 - GO" << std::endl;
                 return {"L","U'","L'","U"};       
             }
             if (pair.color1=='O' && pair.color2=='B') {
-                std::cout << "RLF2L 2 - OB" << std::endl;
+                log() << "RLF2L 2 - OB" << std::endl;
                 return {"B","U'", "U'","B'"};          
             }
         }
 
         if (c1 == DOWN && c2 == UP) {
-            std::cout << "RLF2L 12 - ALL" << std::endl;
+            log() << "RLF2L 12 - ALL" << std::endl;
             return {"R'","R'","U","U","R"};
         }
 
         if (c1 == UP && c2 == RIGHT) {
-            std::cout << "F2L: white RIGHT + edge UR found" << std::endl;
+            log() << "F2L: white RIGHT + edge UR found" << std::endl;
             return {"U'","R","U","R'", "U"};
         }
 
         if (c1 == UP && c2 == BACK) {
-            std::cout << "RLF2L 8" << std::endl;
+            log() << "RLF2L 8" << std::endl;
             return {"U'","F","U","U","F'"};
         }
 
         if (c1 == UP && c2 == LEFT) {
-            std::cout << "RLF2L 6" << std::endl;
+            log() << "RLF2L 6" << std::endl;
             return {"U'","F","U","F'"};   // kept first instance as requested
         }
 
         if (c1 == BACK && c2 == UP) {
-            std::cout << "RLF2L 4" << std::endl;
+            log() << "RLF2L 4" << std::endl;
             return {"R'","U","R", "U"};
         }
 
         if (c1 == LEFT && c2 == UP) {
-            std::cout << "RLF2L 10" << std::endl;
+            log() << "RLF2L 10" << std::endl;
             return {"U'","F","U'","F'"};
         }
 
         if (c1 == RIGHT && c2 == UP) {
-            std::cout << "RLF2L 14" << std::endl;
+            log() << "RLF2L 14" << std::endl;
             return {"U","R'","U","U","R"};
         }
     }
@@ -1025,56 +1062,56 @@ std::vector<std::string> Solver::insertF2LPair(const F2LPair& pair, glm::ivec3 c
         if (c1 == RIGHT && c2 == UP)
         {
             if (pair.color1=='R' && pair.color2=='G') {
-                std::cout << "RLF2L 1 - RG" << std::endl;
+                log() << "RLF2L 1 - RG" << std::endl;
                 return {"U'","R'","U","R"};
             }
             if (pair.color1=='B' && pair.color2=='R') {
-                std::cout << "RLF2L 1 - BR" << std::endl;
+                log() << "RLF2L 1 - BR" << std::endl;
                 return {"B'","U","B"};
             }
             if (pair.color1=='G' && pair.color2=='O') {
-                std::cout << "RLF2L 1 - OG" << std::endl;
+                log() << "RLF2L 1 - OG" << std::endl;
                 return {"U","F'","U","U","F"};
             }
             if (pair.color1=='O' && pair.color2=='B') {
-                std::cout << "RLF2L 1 - OB" << std::endl;
+                log() << "RLF2L 1 - OB" << std::endl;
                 return {"L'","U'","U'","L"};
             }
         }
 
         if (c1 == FRONT && c2 == UP) {
-            std::cout << "RLF2L 3" << std::endl;
+            log() << "RLF2L 3" << std::endl;
             return {"F","U","U","F'", "U'"};
         }
 
         // UP + LEFT (first occurrence) kept
         if (c1 == UP && c2 == LEFT) {
-            std::cout << "RLF2L 3" << std::endl;
+            log() << "RLF2L 3" << std::endl;
             return {"F","U","U","F'","U'"};
         }
 
         if (c1 == UP && c2 == FRONT) {
-            std::cout << "F2L: white FRONT + edge UF" << std::endl;
+            log() << "F2L: white FRONT + edge UF" << std::endl;
             return {"F","U'","F'"};
         }
 
         if (c1 == BACK && c2 == UP) {
-            std::cout << "RLF2L 9" << std::endl;
+            log() << "RLF2L 9" << std::endl;
             return {"U", "R'", "U", "R" ,"U'"};   
         }
 
         if (c1 == UP && c2 == BACK) {
-            std::cout << "RLF2L 9 (reversed)" << std::endl;
+            log() << "RLF2L 9 (reversed)" << std::endl;
             return {"U", "R'", "U", "R" ,"U'"};
         }
 
         if (c1 == UP && c2 == RIGHT) {
-            std::cout << "RLF2L 11" << std::endl;
+            log() << "RLF2L 11" << std::endl;
             return {"U","R'","U","U","R"};
         }
 
         if (c1 == LEFT && c2 == UP) {
-            std::cout << "RLF2L 7, FIXED INSERTION" << std::endl;
+            log() << "RLF2L 7, FIXED INSERTION" << std::endl;
             return {"U", "R'", "U", "U", "R"};
         }
     }
@@ -1082,36 +1119,36 @@ std::vector<std::string> Solver::insertF2LPair(const F2LPair& pair, glm::ivec3 c
     if (whiteOnCorner == UP)
     {
         if (c1 == LEFT && c2 == UP) {
-            std::cout << "RLF2L 17" << std::endl;
+            log() << "RLF2L 17" << std::endl;
             return {"F","U","U","F'","U'"};    
         }
         if (c1 == UP && c2 == FRONT) {
-            std::cout << "RLF2L 18" << std::endl;
+            log() << "RLF2L 18" << std::endl;
             return {"R'", "U'", "R", "U", "R'", "U'", "R"};   
         }
         if (c1 == UP && c2 == BACK) {
-            std::cout << "RLF2L 19" << std::endl;
+            log() << "RLF2L 19" << std::endl;
             return {"F","U'","F'", "U"};      
         }
         if (c1 == UP && c2 == LEFT) {
-            std::cout << "RLF2L 20" << std::endl;
+            log() << "RLF2L 20" << std::endl;
             return {"R'","U","R", "U"};             
         }
         if (c1 == BACK && c2 == UP) {
-            std::cout << "RLF2L 19 (reversed)" << std::endl;
+            log() << "RLF2L 19 (reversed)" << std::endl;
             return {"F","U'","F'"};            
         }
         if (c1 == UP && c2 == RIGHT) {
-            std::cout << "RLF2L 24" << std::endl;
+            log() << "RLF2L 24" << std::endl;
             return {"F","U","U", "F'", "U"};             
 
         }
         if (c1 == RIGHT && c2 == UP) {
-            std::cout << "RLF2L 17 (reversed)" << std::endl;
+            log() << "RLF2L 17 (reversed)" << std::endl;
             return {"F","U","U","F'"};         
         }
         if (c1 == FRONT && c2 == UP) {
-            std::cout << "RLF2L 23 (reversed)" << std::endl;
+            log() << "RLF2L 23 (reversed)" << std::endl;
             return {"R'","U","U","R"};         
         }
     }
@@ -1134,7 +1171,7 @@ std::string Solver::faceToString(Face face) const {
 }
 
 bool Solver::isF2LPairSolved(const F2LPair& pair) const {
-    const auto& cur = cube->getCurrentPosition();
+    const auto& cur = currentPositions();
 
     // 1. Check if corner is in correct slot
     if (cur.at(pair.cornerID) != pair.targetCornerPos)
@@ -1145,8 +1182,8 @@ bool Solver::isF2LPairSolved(const F2LPair& pair) const {
         return false;
 
     // 3. Get cubelets
-    Cubelet* corner = cube->getCubelet(pair.targetCornerPos);
-    Cubelet* edge   = cube->getCubelet(pair.targetEdgePos);
+    const CubePiece* corner = pieceAt(pair.targetCornerPos);
+    const CubePiece* edge   = pieceAt(pair.targetEdgePos);
 
     if (!corner || !edge) return false;
 
@@ -1195,7 +1232,7 @@ bool Solver::isF2LPairSolved(const F2LPair& pair) const {
     return true;
 }
 
-Face Solver::getColorFace(Cubelet* piece, char targetColor) const {
+Face Solver::getColorFace(const CubePiece* piece, char targetColor) const {
     std::vector<Face> faces = {UP, DOWN, FRONT, BACK, RIGHT, LEFT};
     for (Face face : faces) {
         if (getFaceColor(piece, face) == targetColor) {
@@ -1205,7 +1242,7 @@ Face Solver::getColorFace(Cubelet* piece, char targetColor) const {
     return UP; // Default
 }
 
-bool Solver::isCornerOrientedCorrectly(Cubelet* piece) const {
+bool Solver::isCornerOrientedCorrectly(const CubePiece* piece) const {
     if (!piece) return false;
     return getFaceColor(piece, DOWN) == 'W';
 }
@@ -1227,8 +1264,8 @@ bool Solver::isLCorrectOrientation() {
     glm::ivec3 UB(0, 1, -1);   // Back edge
     glm::ivec3 UL(-1, 1, 0);   // Left edge
 
-    const Cubelet* cuUB = cube->getCubelet(UB);
-    const Cubelet* cuUL = cube->getCubelet(UL);
+    const CubePiece* cuUB = pieceAt(UB);
+    const CubePiece* cuUL = pieceAt(UL);
 
     if (!cuUB || !cuUL) {
         return false;
@@ -1237,7 +1274,7 @@ bool Solver::isLCorrectOrientation() {
     bool back_yellow = (getFaceColor(cuUB, UP) == 'Y');
     bool left_yellow = (getFaceColor(cuUL, UP) == 'Y');
 
-    std::cout << "[L-Check] Back=" << back_yellow << ", Left=" << left_yellow << "\n";
+    log() << "[L-Check] Back=" << back_yellow << ", Left=" << left_yellow << "\n";
 
     return back_yellow && left_yellow;
 }
@@ -1248,18 +1285,18 @@ bool Solver::isLineHorizontal() {
     glm::ivec3 UL(-1, 1, 0);
     glm::ivec3 UR(1, 1, 0);
 
-    const Cubelet* cuUL = cube->getCubelet(UL);
-    const Cubelet* cuUR = cube->getCubelet(UR);
+    const CubePiece* cuUL = pieceAt(UL);
+    const CubePiece* cuUR = pieceAt(UR);
 
     if (!cuUL || !cuUR) {
-        std::cout << "[isLineHorizontal] Missing cubelet\n";
+        log() << "[isLineHorizontal] Missing cubelet\n";
         return false;
     }
 
     bool ul_yellow = (getFaceColor(cuUL, UP) == 'Y');
     bool ur_yellow = (getFaceColor(cuUR, UP) == 'Y');
 
-    std::cout << "[isLineHorizontal] Left=" << ul_yellow << ", Right=" << ur_yellow << "\n";
+    log() << "[isLineHorizontal] Left=" << ul_yellow << ", Right=" << ur_yellow << "\n";
 
     return ul_yellow && ur_yellow;
 }
@@ -1270,13 +1307,13 @@ OLLState Solver::detectOLLState() {
     const glm::ivec3 UB(0, 1, -1);
     const glm::ivec3 UL(-1, 1, 0);
 
-    const Cubelet* cuUF = cube->getCubelet(UF);
-    const Cubelet* cuUR = cube->getCubelet(UR);
-    const Cubelet* cuUB = cube->getCubelet(UB);
-    const Cubelet* cuUL = cube->getCubelet(UL);
+    const CubePiece* cuUF = pieceAt(UF);
+    const CubePiece* cuUR = pieceAt(UR);
+    const CubePiece* cuUB = pieceAt(UB);
+    const CubePiece* cuUL = pieceAt(UL);
 
     if (!cuUF || !cuUR || !cuUB || !cuUL) {
-        std::cout << "[detectOLLState] missing cubelet(s) — defaulting to DOT\n";
+        log() << "[detectOLLState] missing cubelet(s) — defaulting to DOT\n";
         return DOT;
     }
 
@@ -1288,14 +1325,14 @@ OLLState Solver::detectOLLState() {
     int count = (int)uf_up + (int)ur_up + (int)ub_up + (int)ul_up;
 
     // Debug: show what colors are actually on UP face
-    std::cout << "[detectOLLState] UP face colors:\n";
-    std::cout << "  Front edge (0,1,1): " << getFaceColor(cuUF, UP) << " (yellow=" << uf_up << ")\n";
-    std::cout << "  Right edge (1,1,0): " << getFaceColor(cuUR, UP) << " (yellow=" << ur_up << ")\n";
-    std::cout << "  Back edge (0,1,-1): " << getFaceColor(cuUB, UP) << " (yellow=" << ub_up << ")\n";
-    std::cout << "  Left edge (-1,1,0): " << getFaceColor(cuUL, UP) << " (yellow=" << ul_up << ")\n";
+    log() << "[detectOLLState] UP face colors:\n";
+    log() << "  Front edge (0,1,1): " << getFaceColor(cuUF, UP) << " (yellow=" << uf_up << ")\n";
+    log() << "  Right edge (1,1,0): " << getFaceColor(cuUR, UP) << " (yellow=" << ur_up << ")\n";
+    log() << "  Back edge (0,1,-1): " << getFaceColor(cuUB, UP) << " (yellow=" << ub_up << ")\n";
+    log() << "  Left edge (-1,1,0): " << getFaceColor(cuUL, UP) << " (yellow=" << ul_up << ")\n";
 
 
-    std::cout << "[detectOLLState] Yellow edges facing up: " << count << "\n";
+    log() << "[detectOLLState] Yellow edges facing up: " << count << "\n";
 
     if (count == 4) {
         return CROSS_SHAPE;
@@ -1303,14 +1340,14 @@ OLLState Solver::detectOLLState() {
     if (count == 2) {
         // Line: opposite edges (UF+UB or UR+UL)
         if ((uf_up && ub_up) || (ur_up && ul_up)) {
-            std::cout << "[detectOLLState] -> LINE (opposite edges)\n";
+            log() << "[detectOLLState] -> LINE (opposite edges)\n";
             return LINE_SHAPE;
         }
         // L-shape: adjacent edges
-        std::cout << "[detectOLLState] -> L-SHAPE (adjacent edges)\n";
+        log() << "[detectOLLState] -> L-SHAPE (adjacent edges)\n";
         return L_SHAPE;
     }
-    std::cout << "[detectOLLState] -> DOT\n";
+    log() << "[detectOLLState] -> DOT\n";
     return DOT;
 }
 
@@ -1320,36 +1357,36 @@ std::vector<std::string> Solver::solveOLLCross() {
 
     switch (state) {
         case CROSS_SHAPE:
-            std::cout << "OLL already solved (cross)" << std::endl;
+            log() << "OLL already solved (cross)" << std::endl;
             return {};
 
         case LINE_SHAPE: {
             for (int i = 0; i < 2; i++) {
                 if (isLineHorizontal()) {
-                    std::cout << "OLL Line pattern -> applying algorithm" << std::endl;
-                    return { "F'", "R'", "U'", "R", "U", "F" };
+                    log() << "OLL Line pattern -> applying algorithm" << std::endl;
+                    return algorithmMoves(OLL_LINE);
                 }
                 return {"U"};
             }
-            std::cout << "WARNING: Line not detected as horizontal after 4 rotations, applying algorithm anyway" << std::endl;
-            return {"F'", "R'", "U", "R", "U'", "F"};
+            log() << "WARNING: Line not detected as horizontal after 4 rotations, applying algorithm anyway" << std::endl;
+            return algorithmMoves(OLL_LINE_UNALIGNED);
 
         }
 
         case L_SHAPE: {
             if (isLCorrectOrientation()) {
-                std::cout << "OLL L pattern -> applying algorithm" << std::endl;
-                return { "F'", "R'", "U'", "R", "U", "F" };
+                log() << "OLL L pattern -> applying algorithm" << std::endl;
+                return algorithmMoves(OLL_LINE);
                 break;
             }
             // Not oriented correctly, rotate U and check again
-            std::cout << "L not oriented, rotating U'" << std::endl;
+            log() << "L not oriented, rotating U'" << std::endl;
             return {"U'"};
         }
 
         case DOT:{
-            std::cout << "OLL Dot -> apply L then Line" << std::endl;
-            return {"R'", "U", "R", "U'", "F", "U'", "U'", "F'", "U'", "F", "U'", "U'", "F'"};
+            log() << "OLL Dot -> apply L then Line" << std::endl;
+            return algorithmMoves(OLL_DOT);
             }
         }
 
@@ -1359,14 +1396,14 @@ std::vector<std::string> Solver::solveOLLCross() {
 // PLL
 int Solver::countAlignedEdges_Fixed() {
     int count = 0;
-    std::cout << "\n=== CHECKING EDGE ALIGNMENT ===" << std::endl;
+    log() << "\n=== CHECKING EDGE ALIGNMENT ===" << std::endl;
     for (int i = 0; i < 4; i++) {
         if (isEdgeAligned(i)) {
             count++;
         }
     }
 
-    std::cout << "Total aligned: " << count << "/4" << std::endl;
+    log() << "Total aligned: " << count << "/4" << std::endl;
 
     return count;
 }
@@ -1379,7 +1416,7 @@ bool Solver::edgeMatchesCenter_Fixed(int edgeIndex) {
         {-1, 1, 0}   // LEFT edge
     };
 
-    Cubelet* edge = cube->getCubelet(edgePositions[edgeIndex]);
+    const CubePiece* edge = pieceAt(edgePositions[edgeIndex]);
     if (!edge) return false;
 
     Face faceToCheck;
@@ -1407,18 +1444,18 @@ bool Solver::edgeMatchesCenter_Fixed(int edgeIndex) {
         centerFaceToCheck = LEFT;
     }
 
-    color edgeColor = edge->getFaceColor(faceToCheck);
+    char edgeColor = edge->getFaceColor(faceToCheck);
 
-    Cubelet* center = cube->getCubelet(centerPos);
+    const CubePiece* center = pieceAt(centerPos);
     if (!center) return false;
 
-    color centerColor = center->getFaceColor(centerFaceToCheck);
+    char centerColor = center->getFaceColor(centerFaceToCheck);
 
-    bool match = sameColor(edgeColor, centerColor);
+    bool match = edgeColor == centerColor;
 
-    std::cout << "  Edge " << edgeIndex
-              << ": " << colorToChar(edgeColor)
-              << " vs center " << colorToChar(centerColor)
+    log() << "  Edge " << edgeIndex
+              << ": " << edgeColor
+              << " vs center " << centerColor
               << " = " << (match ? "MATCH" : "NO MATCH") << std::endl;
 
     return match;
@@ -1427,7 +1464,7 @@ bool Solver::edgeMatchesCenter_Fixed(int edgeIndex) {
 // PLL
 
 std::vector<std::string> Solver::solveLastLayerEdges_Fixed() {
-    std::cout << "\n=== PLL EDGE ANALYSIS ===" << std::endl;
+    log() << "\n=== PLL EDGE ANALYSIS ===" << std::endl;
     //Edge 0: FRONT edge (0,1,1) = Green-Yellow edge
     //Edge 1: RIGHT edge (1,1,0) = Blue-Yellow edge
     //Edge 2: BACK edge (0,1,-1) = Red-Yellow edge
@@ -1442,15 +1479,15 @@ std::vector<std::string> Solver::solveLastLayerEdges_Fixed() {
         }
     } else {
         if (isEdgeAligned(0)) {
-            std::cout << "green lined up" << endl;
+            log() << "green lined up" << std::endl;
             baseEdge = false;
             return {"B'", "U'", "U'", "B", "U", "B'", "U", "B", "U'"};
         } else if (isEdgeAligned(1)){
-            std::cout << "red lined up" << endl;
+            log() << "red lined up" << std::endl;
         baseEdge = false;
         return {"U'", "R'", "U'", "R", "U'", "R'", "U'", "U'", "R", "U'", "L'", "U'", "L", "U'", "L'", "U'", "U'", "L", "U'"}; //"B'", "U", "U", "B", "U", "B'", "U", "B", "U"};
         } else {
-            std::cout << "blue lined up" << endl;
+            log() << "blue lined up" << std::endl;
             baseEdge = false;
             return {"R'", "U'", "U'", "R", "U", "R'", "U", "R", "U'"};
         }
@@ -1478,42 +1515,38 @@ bool Solver::isEdgeAligned(int edgeIndex) {
     };
 
     if (edgeIndex < 0 || edgeIndex >= 4) {
-        std::cout << "ERROR: Invalid edge index " << edgeIndex << std::endl;
+        log() << "ERROR: Invalid edge index " << edgeIndex << std::endl;
         return false;
     }
 
     const EdgeInfo& edgeInfo = edges[edgeIndex];
 
     // Get the center piece
-    Cubelet* centerPiece = cube->getCubelet(edgeInfo.centerPosition);
+    const CubePiece* centerPiece = pieceAt(edgeInfo.centerPosition);
     if (!centerPiece) {
-        std::cout << "ERROR: Could not get center piece for edge " << edgeIndex
+        log() << "ERROR: Could not get center piece for edge " << edgeIndex
                   << " at position (" << edgeInfo.centerPosition.x << ","
                   << edgeInfo.centerPosition.y << "," << edgeInfo.centerPosition.z << ")" << std::endl;
         return false;
     }
 
     // Get the edge piece
-    Cubelet* edgePiece = cube->getCubelet(edgeInfo.position);
+    const CubePiece* edgePiece = pieceAt(edgeInfo.position);
     if (!edgePiece) {
-        std::cout << "ERROR: Could not get edge piece for edge " << edgeIndex
+        log() << "ERROR: Could not get edge piece for edge " << edgeIndex
                   << " at position (" << edgeInfo.position.x << ","
                   << edgeInfo.position.y << "," << edgeInfo.position.z << ")" << std::endl;
         return false;
     }
 
     // Get the colors
-    color centerColorRGB = centerPiece->getFaceColor(edgeInfo.centerFaceToCheck);
-    color edgeColorRGB = edgePiece->getFaceColor(edgeInfo.edgeFaceToCheck);
+    char centerChar = centerPiece->getFaceColor(edgeInfo.centerFaceToCheck);
+    char edgeChar = edgePiece->getFaceColor(edgeInfo.edgeFaceToCheck);
 
     // Check if they match
-    bool match = sameColor(edgeColorRGB, centerColorRGB);
-
-    // Optional: Print debug info
-    char centerChar = colorToChar(centerColorRGB);
-    char edgeChar = colorToChar(edgeColorRGB);
+    bool match = edgeChar == centerChar;
 
-    std::cout << "Edge " << edgeIndex << " (" << edgeInfo.name << "): "
+    log() << "Edge " << edgeIndex << " (" << edgeInfo.name << "): "
               << "Edge color = " << edgeChar << ", Center color = " << centerChar
               << " -> " << (match ? "ALIGNED" : "MISALIGNED") << std::endl;
 
@@ -1551,14 +1584,14 @@ std::vector<std::string> Solver::findCorrectEdgePair() {
 
 // PLL Solving the Corners
 bool Solver::cornerInCorrectLocation_Fixed(glm::ivec3 pos) {
-    Cubelet* corner = cube->getCubelet(pos);
+    const CubePiece* corner = pieceAt(pos);
     if (!corner) {
-        std::cout << "  Corner at (" << pos.x << "," << pos.y << "," << pos.z
+        log() << "  Corner at (" << pos.x << "," << pos.y << "," << pos.z
                   << "): NULL" << std::endl;
         return false;
     }
 
-    std::cout << "  Checking corner at (" << pos.x << "," << pos.y << "," << pos.z << ")" << std::endl;
+    log() << "  Checking corner at (" << pos.x << "," << pos.y << "," << pos.z << ")" << std::endl;
 
     // Get the ACTUAL visible colors on this corner (after XX rotation)
     char cornerRight = getFaceColor(corner, RIGHT);
@@ -1568,49 +1601,49 @@ bool Solver::cornerInCorrectLocation_Fixed(glm::ivec3 pos) {
     char cornerUp = getFaceColor(corner, UP);
     char cornerDown = getFaceColor(corner, DOWN);
 
-    std::cout << "  Corner colors: R=" << cornerRight << " L=" << cornerLeft
+    log() << "  Corner colors: R=" << cornerRight << " L=" << cornerLeft
               << " F=" << cornerFront << " B=" << cornerBack
               << " U=" << cornerUp << " D=" << cornerDown << std::endl;
 
     // For debugging, let's just check if the corner has yellow on UP
     // This is a simpler check that might work
     if (cornerUp == 'Y') {
-        std::cout << "  Corner has yellow on UP face" << std::endl;
+        log() << "  Corner has yellow on UP face" << std::endl;
 
         // Also check if it matches one adjacent center
         bool matchesOneCenter = false;
 
         if (pos.x == 1 && cornerRight == 'R') {
-            std::cout << "  Matches RIGHT center" << std::endl;
+            log() << "  Matches RIGHT center" << std::endl;
             matchesOneCenter = true;
         }
         if (pos.x == -1 && cornerLeft == 'O') {
-            std::cout << "  Matches LEFT center" << std::endl;
+            log() << "  Matches LEFT center" << std::endl;
             matchesOneCenter = true;
         }
         if (pos.z == 1 && cornerBack == 'G') {
-            std::cout << "  Matches FRONT center (via BACK face)" << std::endl;
+            log() << "  Matches FRONT center (via BACK face)" << std::endl;
             matchesOneCenter = true;
         }
         if (pos.z == -1 && cornerFront == 'B') {
-            std::cout << "  Matches BACK center (via FRONT face)" << std::endl;
+            log() << "  Matches BACK center (via FRONT face)" << std::endl;
             matchesOneCenter = true;
         }
 
         return matchesOneCenter;
     }
 
-    std::cout << "  Corner does NOT have yellow on UP face" << std::endl;
+    log() << "  Corner does NOT have yellow on UP face" << std::endl;
     return false;
 }
 
 int Solver::countCorrectCorners_Fixed() {
-    std::cout << "\n=== CHECKING CORNER LOCATIONS ===" << std::endl;
+    log() << "\n=== CHECKING CORNER LOCATIONS ===" << std::endl;
     return countCorrectCornerOrientations();
 }
 
 int Solver::countCorrectCornerOrientations() {
-    std::cout << "\n=== CHECKING CORNER ORIENTATIONS ===" << std::endl;
+    log() << "\n=== CHECKING CORNER ORIENTATIONS ===" << std::endl;
 
     static const glm::ivec3 corners[4] = {
         {1, 1, 1}, {1, 1, -1}, {-1, 1, -1}, {-1, 1, 1}
@@ -1618,48 +1651,48 @@ int Solver::countCorrectCornerOrientations() {
 
     int count = 0;
     for (int i = 0; i < 4; i++) {
-        Cubelet* corner = cube->getCubelet(corners[i]);
+        const CubePiece* corner = pieceAt(corners[i]);
         if (corner) {
             char upColor = getFaceColor(corner, UP);
-            std::cout << "Corner " << i << " at (" << corners[i].x << ","
+            log() << "Corner " << i << " at (" << corners[i].x << ","
                       << corners[i].y << "," << corners[i].z
                       << "): UP=" << upColor;
 
             if (upColor == 'Y') {
                 count++;
-                std::cout << " ✓ YELLOW" << std::endl;
+                log() << " ✓ YELLOW" << std::endl;
             } else {
-                std::cout << " ✗ NOT YELLOW" << std::endl;
+                log() << " ✗ NOT YELLOW" << std::endl;
             }
         }
     }
 
-    std::cout << "Correct orientations: " << count << "/4" << std::endl;
+    log() << "Correct orientations: " << count << "/4" << std::endl;
     return count;
 }
 
 std::vector<std::string> Solver::solveLastLayerCorners_Fixed() {
     int correctLocation = countCorrectCornersLocations();
-    std::cout << "correctLocation: " << correctLocation << std::endl;
+    log() << "correctLocation: " << correctLocation << std::endl;
     if (correctLocation == 0) {
-        std::cout << "Case A.5" << std::endl;
-        return {"R'", "U", "L", "U'", "R", "U", "L'", "U'"};
+        log() << "Case A.5" << std::endl;
+        return algorithmMoves(CORNER_CYCLE_D);
     } else if (correctLocation == 1) {
         if (isCornerInCorrectLocation(0)) {
-            std::cout << "Case A" << std::endl;
-            return {"L", "U'", "R'", "U", "L'", "U'", "R", "U"};
+            log() << "Case A" << std::endl;
+            return algorithmMoves(CORNER_CYCLE_A);
         } else if (isCornerInCorrectLocation(1)) {
-            std::cout << "Case B" << std::endl;
-            return {"F", "U'", "B'", "U", "F'", "U'", "B", "U"};
+            log() << "Case B" << std::endl;
+            return algorithmMoves(CORNER_CYCLE_B);
         } else if (isCornerInCorrectLocation(2)) {
-            std::cout << "Case C" << std::endl;
-            return {"R", "U'", "L'", "U", "R'", "U'", "L", "U"};
+            log() << "Case C" << std::endl;
+            return algorithmMoves(CORNER_CYCLE_C);
         } else if (isCornerInCorrectLocation(3)) {
-            std::cout << "Case D" << std::endl;
-            return {"R'", "U", "L", "U'", "R", "U", "L'", "U'"};
+            log() << "Case D" << std::endl;
+            return algorithmMoves(CORNER_CYCLE_D);
         }
     } else if (correctLocation == 4){
-        std::cout << "Case E" << std::endl;
+        log() << "Case E" << std::endl;
         return orientCorners();
     }
     return {};
@@ -1667,56 +1700,44 @@ std::vector<std::string> Solver::solveLastLayerCorners_Fixed() {
 
 std::vector<std::string> Solver::orientCorners() {
     int solvedCorners = countCorrectCorners_Fixed();
-    std::cout << "orientCorners" << std::endl;
+    log() << "orientCorners" << std::endl;
     if (solvedCorners == 0) {
-        return {
-        "R'", "U", "U", "R", "U", "R'", "U", "R",
-            "L", "U", "U", "L'", "U'", "L", "U'", "L'"};
+        return algorithmMoves(ORIENT_RIGHT_LEFT);
     }else if (solvedCorners == 1) {
         if (isCornerInCorrectLocation(1) || isCornerInCorrectLocation(2)) {
-            std::cout << "Case 1/2" << std::endl;
-            return {"L", "U", "U", "L'", "U'", "L", "U'", "L'",
-                "R'", "U", "U", "R", "U", "R'", "U", "R"
-                    };
+            log() << "Case 1/2" << std::endl;
+            return algorithmMoves(ORIENT_LEFT_RIGHT);
         } else if (isCornerInCorrectLocation(0) || isCornerInCorrectLocation(3)) {
-            std::cout << "Case 0/3" << std::endl;
-            return {
-                "L", "U", "U", "L'", "U'", "L", "U'", "L'",
-                "R'", "U", "U", "R", "U", "R'", "U", "R"
-                    };
+            log() << "Case 0/3" << std::endl;
+            return algorithmMoves(ORIENT_LEFT_RIGHT);
         }
     }
      else if (solvedCorners == 2) {
         if (isCornerInCorrectLocation(0) && isCornerInCorrectLocation(1)) {
-            std::cout << "Case 0 - 1" << std::endl;
-            return {"B'", "U'", "U'", "B", "U", "B'", "U", "B",
-                       "F", "U'", "U'", "F'", "U'", "F", "U'", "F'"
-
+            log() << "Case 0 - 1" << std::endl;
+            return algorithmMoves(ORIENT_BACK_FRONT);
                 // "L", "U", "U", "L'", "U'", "L", "U'", "L'",
                 // "R'", "U", "U", "R", "U", "R'", "U", "R"
-                    };
         } else if (isCornerInCorrectLocation(1) && isCornerInCorrectLocation(2)) {
-            std::cout << "Case 1 - 2" << std::endl;
+            log() << "Case 1 - 2" << std::endl;
             return {};
                     // "U'",
                     // "R'", "U", "U", "R", "U", "R'", "U", "R",
                     // "L", "U", "U", "L'", "U'", "L", "U'", "L'"};
         } else if (isCornerInCorrectLocation(2) && isCornerInCorrectLocation(3)) {
-            std::cout << "Case 2 - 3" << std::endl;
+            log() << "Case 2 - 3" << std::endl;
             return { };
                     // "R'", "U", "U", "R", "U", "R'", "U", "R",
                     // "L", "U", "U", "L'", "U'", "L", "U'", "L'"};
         } else if (isCornerInCorrectLocation(3) && isCornerInCorrectLocation(1)) {
-            std::cout << "Case 3 - 1" << std::endl;
+            log() << "Case 3 - 1" << std::endl;
             return {};
                    // "U'",
                    // "R'", "U", "U", "R", "U", "R'", "U", "R",
                    //  "L", "U", "U", "L'", "U'", "L", "U'", "L'"};
         } else if (isCornerInCorrectLocation(1) && isCornerInCorrectLocation(3) || isCornerInCorrectLocation(0) && isCornerInCorrectLocation(2)) {
-            std::cout << "Case 1 - 3 or 0 - 2" << std::endl;
-            return {
-                    "R'", "U", "U", "R", "U", "R'", "U", "R",
-                    "L", "U", "U", "L'", "U'", "L", "U'", "L'"};
+            log() << "Case 1 - 3 or 0 - 2" << std::endl;
+            return algorithmMoves(ORIENT_RIGHT_LEFT);
         }
     } else if (solvedCorners == 4) {
         fullySolved = true;
@@ -1736,7 +1757,7 @@ bool Solver::isCornerInCorrectLocation(int cornerIndex) {
 
     if (cornerIndex < 0 || cornerIndex >= 4) return false;
 
-    Cubelet* corner = cube->getCubelet(positions[cornerIndex]);
+    const CubePiece* corner = pieceAt(positions[cornerIndex]);
     if (!corner) return false;
 
     // Get all visible colors
@@ -1767,7 +1788,7 @@ bool Solver::isCornerCorrectlyOriented(int cornerIndex) {
 
     if (cornerIndex < 0 || cornerIndex >= 4) return false;
 
-    Cubelet* corner = cube->getCubelet(positions[cornerIndex]);
+    const CubePiece* corner = pieceAt(positions[cornerIndex]);
     if (!corner) return false;
 
     return (getFaceColor(corner, UP) == 'Y');
@@ -1783,7 +1804,7 @@ int Solver::countCorrectCornersLocations() {
     return count;
 }
 
-color Solver::centerColor(Face f) {
+char Solver::centerColor(Face f) {
     glm::ivec3 pos;
 
     switch (f) {
@@ -1795,7 +1816,7 @@ color Solver::centerColor(Face f) {
         case DOWN:  pos = {0,-1,0}; break;
     }
 
-    return cube->getCubelet(pos)->getFaceColor(f);
+    return pieceAt(pos)->getFaceColor(f);
 }
 
 bool Solver::areCornersSolved_Fixed() {
@@ -1806,15 +1827,15 @@ bool Solver::areCornersSolved_Fixed() {
 
     // First check all corners have yellow on UP
     for (const auto& pos : corners) {
-        Cubelet* corner = cube->getCubelet(pos);
+        const CubePiece* corner = pieceAt(pos);
         if (!corner || getFaceColor(corner, UP) != 'Y') {
-            std::cout << "  Corner at (" << pos.x << "," << pos.y << "," << pos.z
+            log() << "  Corner at (" << pos.x << "," << pos.y << "," << pos.z
                       << ") missing or doesn't have yellow on UP" << std::endl;
             return false;
         }
     }
 
-    std::cout << "  All corners have yellow on UP ✓" << std::endl;
+    log() << "  All corners have yellow on UP ✓" << std::endl;
 
     // NOW check if they're in correct positions
     // After XX rotation, what we see at each position:
@@ -1824,62 +1845,62 @@ bool Solver::areCornersSolved_Fixed() {
     // - At LEFT position (X=-1): we see LEFT face of corner
 
     // Check corner 0: (1,1,1) - UFR
-    Cubelet* corner0 = cube->getCubelet({1, 1, 1});
+    const CubePiece* corner0 = pieceAt({1, 1, 1});
     if (corner0) {
         char right0 = getFaceColor(corner0, RIGHT);
         char back0 = getFaceColor(corner0, BACK);
 
         // Should be R on RIGHT and G on BACK
         if (right0 != 'R' || back0 != 'G') {
-            std::cout << "  Corner 0 (UFR) wrong: R=" << right0 << " B=" << back0
+            log() << "  Corner 0 (UFR) wrong: R=" << right0 << " B=" << back0
                       << " (should be R and G)" << std::endl;
             return false;
         }
     }
 
     // Check corner 1: (1,1,-1) - URB
-    Cubelet* corner1 = cube->getCubelet({1, 1, -1});
+    const CubePiece* corner1 = pieceAt({1, 1, -1});
     if (corner1) {
         char right1 = getFaceColor(corner1, RIGHT);
         char front1 = getFaceColor(corner1, FRONT);
 
         // Should be R on RIGHT and B on FRONT
         if (right1 != 'R' || front1 != 'B') {
-            std::cout << "  Corner 1 (URB) wrong: R=" << right1 << " F=" << front1
+            log() << "  Corner 1 (URB) wrong: R=" << right1 << " F=" << front1
                       << " (should be R and B)" << std::endl;
             return false;
         }
     }
 
     // Check corner 2: (-1,1,-1) - UBL
-    Cubelet* corner2 = cube->getCubelet({-1, 1, -1});
+    const CubePiece* corner2 = pieceAt({-1, 1, -1});
     if (corner2) {
         char left2 = getFaceColor(corner2, LEFT);
         char front2 = getFaceColor(corner2, FRONT);  // Shows at BACK position
 
         // Should be O on LEFT and B on FRONT
         if (left2 != 'O' || front2 != 'B') {
-            std::cout << "  Corner 2 (UBL) wrong: L=" << left2 << " F=" << front2
+            log() << "  Corner 2 (UBL) wrong: L=" << left2 << " F=" << front2
                       << " (should be O and B)" << std::endl;
             return false;
         }
     }
 
     // Check corner 3: (-1,1,1) - ULF
-    Cubelet* corner3 = cube->getCubelet({-1, 1, 1});
+    const CubePiece* corner3 = pieceAt({-1, 1, 1});
     if (corner3) {
         char left3 = getFaceColor(corner3, LEFT);
         char back3 = getFaceColor(corner3, BACK);
 
         // Should be O on LEFT and G on BACK
         if (left3 != 'O' || back3 != 'G') {
-            std::cout << "  Corner 3 (ULF) wrong: L=" << left3 << " B=" << back3
+            log() << "  Corner 3 (ULF) wrong: L=" << left3 << " B=" << back3
                       << " (should be O and G)" << std::endl;
             return false;
         }
     }
 
-    std::cout << "  All corners in correct positions!" << std::endl;
+    log() << "  All corners in correct positions!" << std::endl;
     return true;
 }
 
@@ -1905,20 +1926,17 @@ static const glm::ivec3 centerPosCorner[4][3] = {
 };
 
 bool Solver::cornerIsCorrect(int idx) {
-    const Cubelet* c = cube->getCubelet(cornerPos[idx]);
+    const CubePiece* c = pieceAt(cornerPos[idx]);
     if (!c) return false;
 
     for (int f = 0; f < 3; f++) {
         Face face = cornerFaces[idx][f];
         glm::ivec3 cp = centerPosCorner[idx][f];
 
-        const Cubelet* center = cube->getCubelet(cp);
+        const CubePiece* center = pieceAt(cp);
         if (!center) return false;
 
-        color c1 = c->getFaceColor(face);
-        color c2 = center->getFaceColor(face);
-
-        if (!sameColor(c1, c2))
+        if (c->getFaceColor(face) != center->getFaceColor(face))
             return false;
     }
     return true;
@@ -1933,28 +1951,28 @@ bool Solver::cornerMatches(int idx) {
     };
 
     const glm::ivec3 pos = cornerPos[idx];
-    const Cubelet* c =  cube->getCubelet(pos);
+    const CubePiece* c =  pieceAt(pos);
     if (!c) return false;
 
     int matchCount = 0;
 
     if (pos.x == 1) {
-        if (sameColor(c->getFaceColor(RIGHT), centerColor(RIGHT))) matchCount++;
+        if (c->getFaceColor(RIGHT) == centerColor(RIGHT)) matchCount++;
     } else {
-        if (sameColor(c->getFaceColor(LEFT), centerColor(LEFT))) matchCount++;
+        if (c->getFaceColor(LEFT) == centerColor(LEFT)) matchCount++;
     }
 
     if (pos.z == 1) {
-        if (sameColor(c->getFaceColor(FRONT), centerColor(FRONT))) matchCount++;
+        if (c->getFaceColor(FRONT) == centerColor(FRONT)) matchCount++;
     } else {
-        if (sameColor(c->getFaceColor(BACK), centerColor(BACK))) matchCount++;
+        if (c->getFaceColor(BACK) == centerColor(BACK)) matchCount++;
     }
 
     return (matchCount == 2);
 }
 
 void Solver::debugCenterColors() {
-    std::cout << "\n=== CENTER COLORS DETAILED (AFTER XX ROTATION) ===" << std::endl;
+    log() << "\n=== CENTER COLORS DETAILED (AFTER XX ROTATION) ===" << std::endl;
 
     glm::ivec3 centerPositions[6] = {
         {0, 1, 0},   // UP
@@ -1968,23 +1986,19 @@ void Solver::debugCenterColors() {
     std::string names[6] = {"UP", "DOWN", "FRONT", "BACK", "RIGHT", "LEFT"};
 
     for (int i = 0; i < 6; i++) {
-        Cubelet* center = cube->getCubelet(centerPositions[i]);
+        const CubePiece* center = pieceAt(centerPositions[i]);
         if (!center) {
-            std::cout << names[i] << " center: NULL" << std::endl;
+            log() << names[i] << " center: NULL" << std::endl;
             continue;
         }
 
-        std::cout << names[i] << " center at (" << centerPositions[i].x << ","
+        log() << names[i] << " center at (" << centerPositions[i].x << ","
                   << centerPositions[i].y << "," << centerPositions[i].z << "):" << std::endl;
 
         // Check ALL faces to see what colors are actually there
         for (Face face : {UP, DOWN, FRONT, BACK, RIGHT, LEFT}) {
-            color rgb = center->getFaceColor(face);
-            char colorChar = colorToChar(rgb);
-
-            std::cout << "  Face " << faceToString(face) << ": RGB("
-                      << rgb.red << "," << rgb.green << "," << rgb.blue
-                      << ") -> '" << colorChar << "'" << std::endl;
+            log() << "  Face " << faceToString(face) << ": '"
+                      << center->getFaceColor(face) << "'" << std::endl;
         }
     }
 }
@@ -1997,21 +2011,20 @@ void Solver::debugFaceIndexOrder() {
         "UP","DOWN","FRONT","BACK","RIGHT","LEFT"
     };
 
-    std::cout << "=== ACTUAL FACE ORDER INSIDE CUBELET ===\n";
+    log() << "=== ACTUAL FACE ORDER INSIDE CUBELET ===\n";
 
     for (int f=0; f<6; f++) {
-        Cubelet* c = cube->getCubelet(centerPos[f]);
-        std::cout << names[f] << ": ";
+        const CubePiece* c = pieceAt(centerPos[f]);
+        log() << names[f] << ": ";
         for (int i=0; i<6; i++) {
-            color col = c->getFaceColor((Face)i);
-            std::cout << colorToChar(col) << " ";
+            log() << c->getFaceColor((Face)i) << " ";
         }
-        std::cout << "\n";
+        log() << "\n";
     }
 }
 
 bool Solver::isCornerCorrectlyOriented(glm::ivec3 pos) const {
-    Cubelet* corner = cube->getCubelet(pos);
+    const CubePiece* corner = pieceAt(pos);
     if (!corner) return false;
 
     // After XX rotation, yellow should be on DOWN face
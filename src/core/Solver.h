@@ -1,7 +1,8 @@
-#ifndef FINAL_PROJECT_QJFOURNI_SOLVER_H
-#define FINAL_PROJECT_QJFOURNI_SOLVER_H
+#ifndef CUBECORE_SOLVER_H
+#define CUBECORE_SOLVER_H
 
-#include "RubiksCube.h"
+#include "CubeState.h"
+#include <iostream>
 #include <vector>
 #include <string>
 #include <memory>
@@ -28,12 +29,19 @@ enum OLLState {
 class Solver {
 public:
     Solver() = default;
-    Solver(RubiksCube* cube);
+    Solver(const CubeState* cube);
 
-    // Main interface
-    void solve(RubiksCube* cube);
+    // Main interface: solve() steps through a live cube, one getNextMove()
+    // per finished turn
+    void solve(const CubeState* cube);
     std::string getNextMove();
 
+    // Runs the whole pipeline on a scratch copy of the state and returns
+    // every move up front, for playback or headless use. When the method
+    // stalls before the cube is solved, isFailed() is set and the moves are
+    // the ones made up to the stall (say, the cross and F2L).
+    std::vector<std::string> computeSolution(const CubeState& state);
+
     // State queries
     bool isSolving() const { return currentState == SOLVING; }
     bool isComplete() const { return currentState == WCCOMPLETE; }
@@ -47,7 +55,7 @@ public:
     int getCurrentStep() const { return currentStep; }
 
     void setState(SolverState state) { currentState = state; }
-    void setCube(RubiksCube* newCube) { cube = newCube; }
+    void setCube(const CubeState* newCube) { cube = newCube; }
 
     bool fullySolved = false;
 
@@ -73,9 +81,14 @@ public:
     bool isDebugFrozen() const { return debugFreeze; }
     bool isStepThrough() const { return stepThroughMode; }
 
+    // Whether the steps narrate their decisions on std::cout (the default).
+    // computeSolution() is always quiet.
+    void setVerbose(bool on) { verbose = on; }
+    bool isVerbose() const { return verbose; }
+
 private:
     // Core data
-    RubiksCube* cube;
+    const CubeState* cube = nullptr;
     SolverState currentState = IDLE;
     
     int currentStep = 0;
@@ -87,7 +100,7 @@ private:
     
     // White Cross state
     char currentTargetColor = 'B';
-    mutable std::map<std::string, int> stuckCount;
+    mutable std::map<uint64_t, int> stuckCount;   // visits per cube state hash
     mutable std::map<char, int> edgeStuckCounter;
     mutable std::map<char, std::vector<glm::ivec3>> previousStates;
     
@@ -130,32 +143,46 @@ private:
     std::map<std::string, int> cornerStuckCount; // For corner tracking
     
     // Debug state
+    bool verbose = true;
+    // Takes the narration when quiet: no buffer, so every write fails and is
+    // dropped. One per solver, since writes set its state bits.
+    mutable std::ostream quiet{nullptr};
     bool debugFreeze = false;
     bool stepThroughMode = false;
     int movesSinceLastFreeze = 0;
 
+    // computeSolution() gives up after this many getNextMove() calls, or
+    // this many in a row that neither turn the cube nor finish (a stall), or
+    // when a state comes back more than MAX_REVISITS times (the steps going
+    // round in a loop)
+    static constexpr int MAX_STEPS = 5000;
+    static constexpr int MAX_IDLE_STEPS = 50;
+    static constexpr int MAX_REVISITS = 8;
+
+    // Where the steps narrate: std::cout, or a stream that drops everything
+    std::ostream& log() const;
+
+    // Clears the per-solve progress (step, target edge, F2L slot, ...)
+    void resetProgress();
+
+    // Reads of the cube state in the grid coordinates the steps work in
+    const CubePiece* pieceAt(glm::ivec3 pos) const { return cube->getPieceAt({pos.x, pos.y, pos.z}); }
+    std::array<glm::ivec3, 26> currentPositions() const;
+    std::array<glm::ivec3, 26> solvedPositions() const;
+
     // Utility functions
-    char colorToChar(const color& c) const;
-    char getFaceColor(const Cubelet* piece, Face face) const;
-    char getWhiteFace(Cubelet* piece) const;
-    Face getColorFace(Cubelet* piece, char targetColor) const;
+    char getFaceColor(const CubePiece* piece, Face face) const;
+    char getWhiteFace(const CubePiece* piece) const;
+    Face getColorFace(const CubePiece* piece, char targetColor) const;
     std::string faceToString(Face face) const;
-    
-    bool sameColor(const color& c1, const color& c2) const {
-        const float epsilon = 0.02f;
-        return std::abs(c1.red - c2.red) < epsilon &&
-               std::abs(c1.green - c2.green) < epsilon &&
-               std::abs(c1.blue - c2.blue) < epsilon;
-    }
 
     // White Cross
     int findWhiteEdge(char targetColor, const std::array<glm::ivec3, 26>& solved) const;
     bool isEdgeSolved(int pieceID, const std::array<glm::ivec3, 26>& current,
-                      const std::array<glm::ivec3, 26>& solved, RubiksCube* cubePtr) const;
+                      const std::array<glm::ivec3, 26>& solved) const;
     std::vector<std::string> solveSingleWhiteEdge(char targetColor,
                                                  const std::array<glm::ivec3, 26>& current,
-                                                 const std::array<glm::ivec3, 26>& solved,
-                                                 RubiksCube* cubePtr) const;
+                                                 const std::array<glm::ivec3, 26>& solved) const;
     bool isWhiteCrossSolved() const;
     bool isYellowCrossSolved() const;
 
@@ -164,14 +191,14 @@ private:
     int findF2LCorner(char color1, char color2) const;
     int findF2LEdge(char color1, char color2) const;
     bool isF2LPairSolved(const F2LPair& pair) const;
-    bool isCornerOrientedCorrectly(Cubelet* corner) const;
+    bool isCornerOrientedCorrectly(const CubePiece* corner) const;
     
     std::vector<std::string> solveF2LPair(const F2LPair& pair, glm::ivec3 cornerPos,
-                                          glm::ivec3 edgePos, Cubelet* corner, Cubelet* edge) const;
+                                          glm::ivec3 edgePos, const CubePiece* corner, const CubePiece* edge) const;
     std::vector<std::string> extractCornerFromSlot(glm::ivec3 pos) const;
     std::vector<std::string> extractEdgeFromMiddle(glm::ivec3 pos) const;
     std::vector<std::string> insertF2LPair(const F2LPair& pair, glm::ivec3 cornerPos, 
-                                           glm::ivec3 edgePos, Cubelet* corner, Cubelet* edge) const;
+                                           glm::ivec3 edgePos, const CubePiece* corner, const CubePiece* edge) const;
 
     // OLL
     OLLState detectOLLState();
@@ -194,7 +221,7 @@ private:
     bool cornerMatches(int idx);
     bool isCornerCorrectlyOriented(glm::ivec3 pos) const;
 
-    color centerColor(Face f);
+    char centerColor(Face f);
 
     // PLL
     bool edgeMatchesCenter_Fixed(int edgeIndex);
@@ -215,4 +242,4 @@ private:
 
 };
 
-#endif // FINAL_PROJECT_QJFOURNI_SOLVER_H
+#endif // CUBECORE_SOLVER_H
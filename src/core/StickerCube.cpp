@@ -0,0 +1,243 @@
+#include "StickerCube.h"
+#include "CpuFeatures.h"
+
+// Net layout of each face in facelet order: which side it is, and the grid
+// directions of one step right along a row and one step down a column
+struct FaceLayout {
+    Face face;
+    GridPos right;
+    GridPos down;
+};
+
+static const FaceLayout FACE_LAYOUT[6] = {
+    {UP,    { 1, 0,  0}, {0,  0,  1}},
+    {RIGHT, { 0, 0, -1}, {0, -1,  0}},
+    {FRONT, { 1, 0,  0}, {0, -1,  0}},
+    {DOWN,  { 1, 0,  0}, {0,  0, -1}},
+    {LEFT,  { 0, 0,  1}, {0, -1,  0}},
+    {BACK,  {-1, 0,  0}, {0, -1,  0}},
+};
+
+static GridPos faceNormal(Face face) {
+    switch (face) {
+        case FRONT: return {0, 0, 1};
+        case BACK:  return {0, 0, -1};
+        case RIGHT: return {1, 0, 0};
+        case LEFT:  return {-1, 0, 0};
+        case UP:    return {0, 1, 0};
+        case DOWN:  return {0, -1, 0};
+    }
+    return {};
+}
+
+static Face faceFromNormal(GridPos n) {
+    for (int f = 0; f < 6; f++) {
+        if (faceNormal((Face)f) == n) return (Face)f;
+    }
+    return UP;
+}
+
+GridPos StickerCube::faceletPosition(int index) {
+    const FaceLayout& layout = FACE_LAYOUT[index / 9];
+    int row = index % 9 / 3 - 1;
+    int col = index % 3 - 1;
+    GridPos n = faceNormal(layout.face);
+    return { n.x + col * layout.right.x + row * layout.down.x,
+             n.y + col * layout.right.y + row * layout.down.y,
+             n.z + col * layout.right.z + row * layout.down.z };
+}
+
+Face StickerCube::faceletFace(int index) {
+    return FACE_LAYOUT[index / 9].face;
+}
+
+static int faceletAt(GridPos pos, Face face) {
+    for (int i = 0; i < StickerCube::FACELET_COUNT; i++) {
+        if (StickerCube::faceletFace(i) == face && StickerCube::faceletPosition(i) == pos) return i;
+    }
+    return -1;
+}
+
+// Control masks for every move. perm[m][j] is the source byte of output byte
+// j; the vector masks split it per register with 0x80 zeroing foreign bytes.
+// vpermb (AVX-512 VBMI) takes perm directly.
+struct StickerMoveTables {
+    alignas(64) uint8_t perm[MOVE_COUNT][64];
+    // AVX2: [move][output ymm][source: lo, lo lane-swapped, hi, hi lane-swapped]
+    alignas(32) uint8_t shuffle256[MOVE_COUNT][2][4][32];
+    // SSSE3: [move][output xmm][source xmm]
+    alignas(16) uint8_t shuffle128[MOVE_COUNT][4][4][16];
+
+    StickerMoveTables();
+};
+
+StickerMoveTables::StickerMoveTables() {
+    static const char FACE_NAMES[] = "URFDLBXYZ";
+
+    for (int face = 0; face < 9; face++) {
+        char axis;
+        int layer;
+        bool clockwise;
+        CubeState::parseMove(std::string(1, FACE_NAMES[face]), axis, layer, clockwise);
+
+        // Source facelet of each output facelet for one quarter turn
+        uint8_t quarter[64];
+        for (int i = 0; i < 64; i++) quarter[i] = i;
+        for (int i = 0; i < StickerCube::FACELET_COUNT; i++) {
+            GridPos pos = StickerCube::faceletPosition(i);
+            int coord = (axis == 'X') ? pos.x : (axis == 'Y') ? pos.y : pos.z;
+            if (coord != layer) continue;
+
+            GridPos newPos = CubeState::calculateNewGridPosition(pos, axis, clockwise);
+            GridPos newNormal = CubeState::calculateNewGridPosition(faceNormal(StickerCube::faceletFace(i)),
+                                                                    axis, clockwise);
+            quarter[faceletAt(newPos, faceFromNormal(newNormal))] = i;
+        }
+
+        uint8_t source[64];
+        for (int i = 0; i < 64; i++) source[i] = i;
+        for (int power = 1; power <= 3; power++) {
+            uint8_t next[64];
+            for (int j = 0; j < 64; j++) next[j] = source[quarter[j]];
+            for (int j = 0; j < 64; j++) source[j] = next[j];
+            for (int j = 0; j < 64; j++) perm[makeMove(face, power)][j] = source[j];
+        }
+    }
+
+    for (int m = 0; m < MOVE_COUNT; m++) {
+        for (int out = 0; out < 2; out++) {
+            for (int s = 0; s < 4; s++) {
+                for (int b = 0; b < 32; b++) {
+                    int lane = b / 16;
+                    // 128-bit lane of the padded cube held in this lane of source s
+                    int heldLane = (s < 2 ? 0 : 2) + ((s % 2 == 0) ? lane : 1 - lane);
+                    int src = perm[m][out * 32 + b];
+                    shuffle256[m][out][s][b] = (src / 16 == heldLane) ? (uint8_t)(src % 16) : 0x80;
+                }
+            }
+        }
+    }
+    for (int m = 0; m < MOVE_COUNT; m++) {
+        for (int out = 0; out < 4; out++) {
+            for (int s = 0; s < 4; s++) {
+                for (int b = 0; b < 16; b++) {
+                    int src = perm[m][out * 16 + b];
+                    shuffle128[m][out][s][b] = (src / 16 == s) ? (uint8_t)(src % 16) : 0x80;
+                }
+            }
+        }
+    }
+}
+
+static const StickerMoveTables TABLES;
+
+StickerCube::StickerCube() {
+    facelets.fill(0);
+    for (int i = 0; i < FACELET_COUNT; i++) {
+        facelets[i] = CubeState::getInitialColors(faceletPosition(i))[faceletFace(i)];
+    }
+}
+
+StickerCube StickerCube::fromCubeState(const CubeState& state) {
+    StickerCube cube;
+    for (int i = 0; i < FACELET_COUNT; i++) {
+        const CubePiece* piece = state.getPieceAt(faceletPosition(i));
+        cube.facelets[i] = piece ? piece->faces[faceletFace(i)] : '?';
+    }
+    return cube;
+}
+
+// --- Move kernels ---
+
+static void applyScalar(uint8_t* facelets, Move m) {
+    uint8_t old[64];
+    for (int j = 0; j < StickerCube::FACELET_COUNT; j++) old[j] = facelets[j];
+    const uint8_t* perm = TABLES.perm[m];
+    for (int j = 0; j < StickerCube::FACELET_COUNT; j++) {
+        facelets[j] = old[perm[j]];
+    }
+}
+
+#if defined(CUBECORE_X86_KERNELS)
+CUBECORE_TARGET("avx512f,avx512bw,avx512vbmi")
+static void applyAVX512(uint8_t* facelets, Move m) {
+    __m512i v = _mm512_load_si512(facelets);
+    v = _mm512_permutexvar_epi8(_mm512_load_si512(TABLES.perm[m]), v);
+    _mm512_store_si512(facelets, v);
+}
+
+CUBECORE_TARGET("avx2")
+static void applyAVX2(uint8_t* facelets, Move m) {
+    __m256i lo = _mm256_load_si256((const __m256i*)facelets);
+    __m256i hi = _mm256_load_si256((const __m256i*)(facelets + 32));
+    __m256i src[4] = { lo, _mm256_permute2x128_si256(lo, lo, 0x01),
+                       hi, _mm256_permute2x128_si256(hi, hi, 0x01) };
+    __m256i out[2];
+    for (int o = 0; o < 2; o++) {
+        const uint8_t (*mask)[32] = TABLES.shuffle256[m][o];
+        __m256i a = _mm256_shuffle_epi8(src[0], _mm256_load_si256((const __m256i*)mask[0]));
+        __m256i b = _mm256_shuffle_epi8(src[1], _mm256_load_si256((const __m256i*)mask[1]));
+        __m256i c = _mm256_shuffle_epi8(src[2], _mm256_load_si256((const __m256i*)mask[2]));
+        __m256i d = _mm256_shuffle_epi8(src[3], _mm256_load_si256((const __m256i*)mask[3]));
+        out[o] = _mm256_or_si256(_mm256_or_si256(a, b), _mm256_or_si256(c, d));
+    }
+    _mm256_store_si256((__m256i*)facelets, out[0]);
+    _mm256_store_si256((__m256i*)(facelets + 32), out[1]);
+}
+
+CUBECORE_TARGET("ssse3")
+static void applySSSE3(uint8_t* facelets, Move m) {
+    __m128i src[4];
+    for (int s = 0; s < 4; s++) src[s] = _mm_load_si128((const __m128i*)(facelets + 16 * s));
+    __m128i out[4];
+    for (int o = 0; o < 4; o++) {
+        const uint8_t (*mask)[16] = TABLES.shuffle128[m][o];
+        __m128i a = _mm_shuffle_epi8(src[0], _mm_load_si128((const __m128i*)mask[0]));
+        __m128i b = _mm_shuffle_epi8(src[1], _mm_load_si128((const __m128i*)mask[1]));
+        __m128i c = _mm_shuffle_epi8(src[2], _mm_load_si128((const __m128i*)mask[2]));
+        __m128i d = _mm_shuffle_epi8(src[3], _mm_load_si128((const __m128i*)mask[3]));
+        out[o] = _mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d));
+    }
+    for (int o = 0; o < 4; o++) _mm_store_si128((__m128i*)(facelets + 16 * o), out[o]);
+}
+#endif
+
+struct StickerKernel {
+    const char* name;
+    void (*apply)(uint8_t* facelets, Move m);
+};
+
+static StickerKernel pickKernel() {
+#if defined(CUBECORE_X86_KERNELS)
+    switch (cpuLevel()) {
+        case CPU_AVX512VBMI: return {"AVX-512 VBMI", applyAVX512};
+        case CPU_AVX2:       return {"AVX2", applyAVX2};
+        case CPU_SSSE3:      return {"SSSE3", applySSSE3};
+        case CPU_SCALAR:     break;
+    }
+#endif
+    return {"scalar", applyScalar};
+}
+
+static const StickerKernel KERNEL = pickKernel();
+
+void StickerCube::applyMoveScalar(Move m) {
+    applyScalar(facelets.data(), m);
+}
+
+void StickerCube::applyMove(Move m) {
+    KERNEL.apply(facelets.data(), m);
+}
+
+bool StickerCube::isSolved() const {
+    for (int face = 0; face < 6; face++) {
+        for (int k = 1; k < 9; k++) {
+            if (facelets[face * 9 + k] != facelets[face * 9]) return false;
+        }
+    }
+    return true;
+}
+
+const char* StickerCube::backendName() {
+    return KERNEL.name;
+}
@@ -0,0 +1,51 @@
+#ifndef CUBECORE_STICKERCUBE_H
+#define CUBECORE_STICKERCUBE_H
+
+#include "CubeState.h"
+#include "Move.h"
+#include <array>
+#include <cstdint>
+
+// Sticker-level cube: the 54 facelets as bytes, 9 per face in U R F D L B
+// order, each face read row by row as it appears on the usual cube net
+// (U and D seen from above/below with F at the bottom/top, the side faces
+// seen from outside with U on top). Colors use CubeState's character codes.
+//
+// Every move is a fixed byte permutation, so applying one is a shuffle
+// against a precomputed control mask instead of per-piece face rotation.
+// The 54 bytes are padded to 64 so the kernel can use whole vector registers;
+// the best one the CPU runs is picked at run time (see CpuFeatures.h):
+//   AVX-512 VBMI: one vpermb
+//   AVX2:         8 vpshufb (vpshufb cannot cross 128-bit lanes)
+//   SSSE3:        16 pshufb
+//   otherwise:    scalar byte gather
+struct alignas(64) StickerCube {
+    static constexpr int FACELET_COUNT = 54;
+
+    std::array<uint8_t, 64> facelets;
+
+    // Solved cube
+    StickerCube();
+
+    void applyMove(Move m);
+    // Portable path, also used to validate the vector kernels
+    void applyMoveScalar(Move m);
+
+    // True when every face shows a single color
+    bool isSolved() const;
+
+    char getFacelet(int index) const { return (char)facelets[index]; }
+    bool operator==(const StickerCube& o) const { return facelets == o.facelets; }
+    bool operator!=(const StickerCube& o) const { return !(*this == o); }
+
+    static StickerCube fromCubeState(const CubeState& state);
+
+    // Grid position of the piece a facelet belongs to and the side it faces
+    static GridPos faceletPosition(int index);
+    static Face faceletFace(int index);
+
+    // Name of the kernel in use ("AVX-512 VBMI", "AVX2", "SSSE3", "scalar")
+    static const char* backendName();
+};
+
+#endif // CUBECORE_STICKERCUBE_H
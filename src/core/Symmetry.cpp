@@ -0,0 +1,257 @@
+#include "Symmetry.h"
+#include <memory>
+
+// --- Geometry ---
+
+static GridPos faceNormal(Face face) {
+    switch (face) {
+        case FRONT: return {0, 0, 1};
+        case BACK:  return {0, 0, -1};
+        case RIGHT: return {1, 0, 0};
+        case LEFT:  return {-1, 0, 0};
+        case UP:    return {0, 1, 0};
+        case DOWN:  return {0, -1, 0};
+    }
+    return {};
+}
+
+static GridPos slotPosition(const Face* faces, int count) {
+    GridPos p;
+    for (int i = 0; i < count; i++) {
+        GridPos n = faceNormal(faces[i]);
+        p.x += n.x;
+        p.y += n.y;
+        p.z += n.z;
+    }
+    return p;
+}
+
+// Signed permutation matrix acting on grid positions
+struct Matrix {
+    int m[3][3];
+
+    GridPos apply(GridPos p) const {
+        return { m[0][0] * p.x + m[0][1] * p.y + m[0][2] * p.z,
+                 m[1][0] * p.x + m[1][1] * p.y + m[1][2] * p.z,
+                 m[2][0] * p.x + m[2][1] * p.y + m[2][2] * p.z };
+    }
+    // Orthogonal, so the inverse is the transpose
+    GridPos applyInverse(GridPos p) const {
+        return { m[0][0] * p.x + m[1][0] * p.y + m[2][0] * p.z,
+                 m[0][1] * p.x + m[1][1] * p.y + m[2][1] * p.z,
+                 m[0][2] * p.x + m[1][2] * p.y + m[2][2] * p.z };
+    }
+    int determinant() const {
+        return m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1])
+             - m[0][1] * (m[1][0] * m[2][2] - m[1][2] * m[2][0])
+             + m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0]);
+    }
+};
+
+static const Matrix URF3_MATRIX = {{{0, 0, 1}, {1, 0, 0}, {0, 1, 0}}};   // (x, y, z) -> (z, x, y)
+static const Matrix F2_MATRIX   = {{{-1, 0, 0}, {0, -1, 0}, {0, 0, 1}}};
+static const Matrix U4_MATRIX   = {{{0, 0, 1}, {0, 1, 0}, {-1, 0, 0}}};  // Y layer clockwise
+static const Matrix LR2_MATRIX  = {{{-1, 0, 0}, {0, 1, 0}, {0, 0, 1}}};
+
+// The cube that moves every piece as the matrix moves space, in the same
+// form as MOVE_CUBES: slot i receives the piece from the slot mapped onto it.
+// A mirror reverses the corners' facelet order, marked by adding 3 to the twist.
+static CubieCube cubeFromMatrix(const Matrix& matrix) {
+    CubieCube c;
+    int mirrored = matrix.determinant() < 0 ? 3 : 0;
+
+    for (int i = 0; i < CORNER_COUNT; i++) {
+        GridPos source = matrix.applyInverse(slotPosition(CORNER_FACES[i], 3));
+        for (int j = 0; j < CORNER_COUNT; j++) {
+            if (slotPosition(CORNER_FACES[j], 3) != source) continue;
+            c.cp[i] = j;
+            GridPos reference = matrix.apply(faceNormal(CORNER_FACES[j][0]));
+            for (int k = 0; k < 3; k++) {
+                if (faceNormal(CORNER_FACES[i][k]) == reference) c.co[i] = k + mirrored;
+            }
+        }
+    }
+    for (int i = 0; i < EDGE_COUNT; i++) {
+        GridPos source = matrix.applyInverse(slotPosition(EDGE_FACES[i], 2));
+        for (int j = 0; j < EDGE_COUNT; j++) {
+            if (slotPosition(EDGE_FACES[j], 2) != source) continue;
+            c.ep[i] = j;
+            GridPos reference = matrix.apply(faceNormal(EDGE_FACES[j][0]));
+            c.eo[i] = faceNormal(EDGE_FACES[i][0]) == reference ? 0 : 1;
+        }
+    }
+    for (int i = 0; i < CENTER_COUNT; i++) {
+        GridPos source = matrix.applyInverse(faceNormal(CENTER_FACES[i]));
+        for (int j = 0; j < CENTER_COUNT; j++) {
+            if (faceNormal(CENTER_FACES[j]) == source) c.ctr[i] = j;
+        }
+    }
+    return c;
+}
+
+// a * b where either side may be mirrored (corner twists 3..5)
+static CubieCube symMultiply(const CubieCube& a, const CubieCube& b) {
+    CubieCube c;
+    for (int i = 0; i < CORNER_COUNT; i++) {
+        c.cp[i] = a.cp[b.cp[i]];
+        int oa = a.co[b.cp[i]], ob = b.co[i];
+        int o;
+        if (oa < 3 && ob < 3) {
+            o = (oa + ob) % 3;
+        } else if (oa < 3) {
+            o = oa + ob;
+            if (o >= 6) o -= 3;
+        } else if (ob < 3) {
+            o = oa - ob;
+            if (o < 3) o += 3;
+        } else {
+            o = oa - ob;
+            if (o < 0) o += 3;
+        }
+        c.co[i] = o;
+    }
+    for (int i = 0; i < EDGE_COUNT; i++) {
+        c.ep[i] = a.ep[b.ep[i]];
+        c.eo[i] = a.eo[b.ep[i]] ^ b.eo[i];
+    }
+    for (int i = 0; i < CENTER_COUNT; i++) {
+        c.ctr[i] = a.ctr[b.ctr[i]];
+    }
+    return c;
+}
+
+static CubieCube conjugateWith(const CubieCube& c, const CubieCube& sym, const CubieCube& symInverse) {
+    return symMultiply(symMultiply(symInverse, c), sym);
+}
+
+// The edges of conjugateWith alone, for coordinates that only read edges;
+// corners and centers are left solved
+static CubieCube conjugateEdges(const CubieCube& c, const CubieCube& sym, const CubieCube& symInverse) {
+    CubieCube r;
+    for (int i = 0; i < EDGE_COUNT; i++) {
+        int j = sym.ep[i], k = c.ep[j];
+        r.ep[i] = symInverse.ep[k];
+        r.eo[i] = symInverse.eo[k] ^ c.eo[j] ^ sym.eo[i];
+    }
+    return r;
+}
+
+// --- Coordinate classes ---
+
+// Walks coordinates in order; each one not yet reached starts a class and
+// its conjugates under the first symCount symmetries fill the class in
+template <class Unrank, class Rank, class Conjugate>
+static SymmetryClasses buildClasses(int count, int symCount, Unrank unrank, Rank rank, Conjugate conjugate) {
+    const SymmetryTables& t = symmetryTables();
+    SymmetryClasses classes;
+    const uint16_t UNSEEN = 0xffff;
+    classes.classOf.assign(count, UNSEEN);
+    classes.symOf.assign(count, 0);
+
+    for (int x = 0; x < count; x++) {
+        if (classes.classOf[x] != UNSEEN) continue;
+
+        uint16_t cls = classes.representative.size();
+        classes.representative.push_back(x);
+        classes.selfSymmetry.push_back(0);
+
+        CubieCube c;
+        unrank(c, x);
+        for (int s = 0; s < symCount; s++) {
+            uint32_t y = rank(conjugate(c, t.cubes[s], t.cubes[t.inverse[s]]));
+            if (y == (uint32_t)x) classes.selfSymmetry[cls] |= 1 << s;
+            if (classes.classOf[y] == UNSEEN) {
+                classes.classOf[y] = cls;
+                classes.symOf[y] = s;
+            }
+        }
+    }
+    return classes;
+}
+
+static void unrankFlipSlice(CubieCube& c, uint32_t flipSlice) {
+    unrankSlice(c, flipSlice / FLIP_COUNT);
+    unrankFlip(c, flipSlice % FLIP_COUNT);
+}
+
+static uint32_t rankFlipSlice(const CubieCube& c) {
+    return rankFlip(c) + FLIP_COUNT * rankSlice(c);
+}
+
+// --- Tables ---
+
+static std::unique_ptr<SymmetryTables> buildSymmetryTables() {
+    auto t = std::make_unique<SymmetryTables>();
+
+    const CubieCube urf3 = cubeFromMatrix(URF3_MATRIX), f2 = cubeFromMatrix(F2_MATRIX);
+    const CubieCube u4 = cubeFromMatrix(U4_MATRIX), lr2 = cubeFromMatrix(LR2_MATRIX);
+    CubieCube a;
+    for (int i = 0; i < 3; i++) {
+        CubieCube b = a;
+        for (int j = 0; j < 2; j++) {
+            CubieCube c = b;
+            for (int k = 0; k < 4; k++) {
+                CubieCube d = c;
+                for (int l = 0; l < 2; l++) {
+                    t->cubes[16 * i + 8 * j + 2 * k + l] = d;
+                    d = symMultiply(d, lr2);
+                }
+                c = symMultiply(c, u4);
+            }
+            b = symMultiply(b, f2);
+        }
+        a = symMultiply(a, urf3);
+    }
+
+    for (int s = 0; s < SYMMETRY_COUNT; s++) {
+        for (int r = 0; r < SYMMETRY_COUNT; r++) {
+            if (symMultiply(t->cubes[s], t->cubes[r]).isSolved()) t->inverse[s] = r;
+        }
+    }
+
+    for (int s = 0; s < SYMMETRY_COUNT; s++) {
+        for (int m = 0; m < FACE_MOVE_COUNT; m++) {
+            CubieCube conjugate = conjugateWith(MOVE_CUBES[m], t->cubes[s], t->cubes[t->inverse[s]]);
+            for (int n = 0; n < FACE_MOVE_COUNT; n++) {
+                if (MOVE_CUBES[n] == conjugate) t->moveConjugate[s][m] = Move(n);
+            }
+        }
+    }
+
+    return t;
+}
+
+const SymmetryTables& symmetryTables() {
+    static const std::unique_ptr<SymmetryTables> tables = buildSymmetryTables();
+    return *tables;
+}
+
+const SymmetryClasses& flipSliceClasses() {
+    static const SymmetryClasses classes =
+        buildClasses(FLIP_COUNT * SLICE_COUNT, UD_SYMMETRY_COUNT, unrankFlipSlice, rankFlipSlice, conjugateEdges);
+    return classes;
+}
+
+const SymmetryClasses& cornerPermClasses() {
+    static const SymmetryClasses classes =
+        buildClasses(CORNER_PERM_COUNT, UD_SYMMETRY_COUNT, unrankCornerPerm, rankCornerPerm, conjugateWith);
+    return classes;
+}
+
+CubieCube symConjugate(const CubieCube& c, int s) {
+    const SymmetryTables& t = symmetryTables();
+    return conjugateWith(c, t.cubes[s], t.cubes[t.inverse[s]]);
+}
+
+int centerRotation(const CubieCube& c) {
+    if (c.ctr == CubieCube().ctr) return 0;
+    const SymmetryTables& t = symmetryTables();
+    for (int s = 0; s < SYMMETRY_COUNT; s += 2) {
+        bool home = true;
+        for (int i = 0; i < CENTER_COUNT; i++) {
+            if (c.ctr[t.cubes[s].ctr[i]] != i) home = false;
+        }
+        if (home) return s;
+    }
+    return 0;
+}
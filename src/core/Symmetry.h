@@ -0,0 +1,68 @@
+#ifndef CUBECORE_SYMMETRY_H
+#define CUBECORE_SYMMETRY_H
+
+#include "Coordinates.h"
+#include "CubieCube.h"
+#include "Move.h"
+#include <cstdint>
+#include <vector>
+
+// The 48 symmetries of the cube (24 rotations, each with and without a
+// left-right mirror), as CubieCubes built from the grid geometry. Symmetry s
+// is URF3^a F2^b U4^c LR2^d with s = 16a + 8b + 2c + d, where
+//   URF3: 120 degrees around the URF-DBL corner axis
+//   F2:   180 degrees around the F-B axis
+//   U4:   90 degrees around the U-D axis
+//   LR2:  the mirror swapping L and R
+// so symmetries 0..15 are the ones that keep the U-D axis, the subgroup the
+// two-phase coordinates are reduced by.
+//
+// Mirrored symmetry cubes hold corner twists 3..5 ("reflected"), which
+// CubieCube::multiply does not handle; use symConjugate().
+
+constexpr int SYMMETRY_COUNT = 48;
+constexpr int UD_SYMMETRY_COUNT = 16;
+
+constexpr int FLIPSLICE_CLASS_COUNT = 64430;   // flip x slice classes under the 16 UD symmetries
+constexpr int CORNER_PERM_CLASS_COUNT = 2768;  // corner permutation classes under the 16 UD symmetries
+
+struct SymmetryTables {
+    CubieCube cubes[SYMMETRY_COUNT];
+    uint8_t inverse[SYMMETRY_COUNT];
+    // Move of symConjugate(MOVE_CUBES[m], s)
+    Move moveConjugate[SYMMETRY_COUNT][FACE_MOVE_COUNT];
+};
+
+// Built on first use (well under a millisecond), then shared
+const SymmetryTables& symmetryTables();
+
+// Coordinate classes of one symmetry reduction. Every coordinate x is
+// symConjugate(representative[classOf[x]], symOf[x]); selfSymmetry[k] has
+// bit s set when symmetry s maps representative k to itself. A
+// representative's symOf is 0. Symmetric positions are the same distance
+// from solved, so a pruning table can keep one entry per class (see
+// TwoPhaseTables).
+struct SymmetryClasses {
+    std::vector<uint16_t> classOf;
+    std::vector<uint8_t> symOf;
+    std::vector<uint32_t> representative;
+    std::vector<uint16_t> selfSymmetry;
+};
+
+// Classes under the 16 UD symmetries, each built on first use:
+// flipslice = flip + FLIP_COUNT * slice (about 3 MB, under a tenth of a second)
+const SymmetryClasses& flipSliceClasses();
+// Corner permutations (about 130 KB, a few milliseconds)
+const SymmetryClasses& cornerPermClasses();
+
+// S^-1 c S, where S is symmetry s: the same state seen through the symmetry.
+// Conjugation respects moves: symConjugate(c * m, s) is
+// symConjugate(c, s) * moveConjugate[s][m].
+CubieCube symConjugate(const CubieCube& c, int s);
+
+// The rotation (an even, unmirrored symmetry) R with c * R having every
+// center home; 0 when the centers are already home. Solvers work on c * R
+// and map each move m of the solution back to moveConjugate[inverse[R]][m].
+int centerRotation(const CubieCube& c);
+
+#endif // CUBECORE_SYMMETRY_H
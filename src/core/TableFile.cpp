@@ -0,0 +1,263 @@
+#include "TableFile.h"
+#include "PruningTable.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// The entries start one page into the file, so they are page aligned when
+// the file is mapped
+constexpr size_t HEADER_BYTES = 4096;
+constexpr char MAGIC[8] = {'C', 'U', 'B', 'E', 'T', 'B', 'L', '\x1a'};
+
+struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t bitsPerEntry;
+    uint64_t states;
+    uint64_t goal;
+    uint64_t bytes;
+    uint64_t checksum;
+    uint32_t moveCount;
+    uint32_t reserved;
+    char coordinate[64];
+    char generator[64];
+};
+static_assert(sizeof(Header) <= HEADER_BYTES, "table file header must fit its page");
+
+// FNV-1a over 64-bit words, with a shift to fold the high bits back in:
+// enough to catch truncation and corruption, and fast enough to check a
+// table on every load
+uint64_t checksum(const uint8_t* data, size_t bytes) {
+    uint64_t hash = 0xcbf29ce484222325ull;
+    size_t i = 0;
+    for (; i + 8 <= bytes; i += 8) {
+        uint64_t word;
+        std::memcpy(&word, data + i, 8);
+        hash = (hash ^ word) * 0x100000001b3ull;
+        hash ^= hash >> 29;
+    }
+    for (; i < bytes; i++) hash = (hash ^ data[i]) * 0x100000001b3ull;
+    return hash;
+}
+
+void copyName(char (&field)[64], const std::string& name) {
+    std::memset(field, 0, sizeof(field));
+    std::memcpy(field, name.data(), std::min(name.size(), sizeof(field) - 1));
+}
+
+bool matches(const Header& header, const TableFileInfo& info) {
+    char coordinate[64];
+    copyName(coordinate, info.coordinate);
+    return std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0 && header.version == TABLE_FILE_VERSION &&
+           header.bitsPerEntry == info.bitsPerEntry && header.states == info.states && header.goal == info.goal &&
+           header.moveCount == info.moveCount && header.bytes == tableFileBytes(info) &&
+           std::memcmp(header.coordinate, coordinate, sizeof(coordinate)) == 0;
+}
+
+Header makeHeader(const TableFileInfo& info, const uint8_t* entries) {
+    Header header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = TABLE_FILE_VERSION;
+    header.bitsPerEntry = info.bitsPerEntry;
+    header.states = info.states;
+    header.goal = info.goal;
+    header.bytes = tableFileBytes(info);
+    header.checksum = checksum(entries, header.bytes);
+    header.moveCount = info.moveCount;
+    copyName(header.coordinate, info.coordinate);
+    copyName(header.generator, info.generator);
+    return header;
+}
+
+long processId() {
+#ifdef _WIN32
+    return (long)GetCurrentProcessId();
+#else
+    return (long)getpid();
+#endif
+}
+
+#ifndef _WIN32
+// The whole of an open file or shared memory object, mapped read-only and
+// unmapped when the last pointer goes; null unless it is size bytes long
+std::shared_ptr<const uint8_t> mapDescriptor(int fd, size_t size) {
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (uint64_t)st.st_size != size) return nullptr;
+    void* view = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    if (view == MAP_FAILED) return nullptr;
+    return std::shared_ptr<const uint8_t>(static_cast<const uint8_t*>(view),
+                                          [size](const uint8_t* p) { munmap((void*)p, size); });
+}
+#endif
+
+// The whole file mapped read-only, unmapped when the last pointer goes;
+// null if it cannot be opened or is not size bytes long
+std::shared_ptr<const uint8_t> mapFile(const std::string& path, size_t size) {
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return nullptr;
+    LARGE_INTEGER fileSize;
+    HANDLE mapping = nullptr;
+    if (GetFileSizeEx(file, &fileSize) && (uint64_t)fileSize.QuadPart == size) {
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    }
+    CloseHandle(file);
+    if (!mapping) return nullptr;
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);  // the view keeps the mapping alive
+    if (!view) return nullptr;
+    return std::shared_ptr<const uint8_t>(static_cast<const uint8_t*>(view),
+                                          [](const uint8_t* p) { UnmapViewOfFile(p); });
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) return nullptr;
+    std::shared_ptr<const uint8_t> view = mapDescriptor(fd, size);
+    close(fd);  // the mapping stays valid
+    return view;
+#endif
+}
+
+} // namespace
+
+size_t tableFileBytes(const TableFileInfo& info) {
+    size_t entriesPerByte = 8 / info.bitsPerEntry;
+    return (size_t)((info.states + entriesPerByte - 1) / entriesPerByte);
+}
+
+bool writeTableFile(const std::string& path, const TableFileInfo& info, const uint8_t* entries) {
+    std::vector<char> page(HEADER_BYTES, 0);
+    Header header = makeHeader(info, entries);
+    std::memcpy(page.data(), &header, sizeof(header));
+
+    std::string temporary = path + ".tmp" + std::to_string(processId());
+    {
+        std::ofstream out(temporary, std::ios::binary);
+        out.write(page.data(), (std::streamsize)page.size());
+        out.write(reinterpret_cast<const char*>(entries), (std::streamsize)header.bytes);
+        if (!out.flush()) {
+            out.close();
+            std::remove(temporary.c_str());
+            return false;
+        }
+    }
+#ifdef _WIN32
+    // rename does not replace an existing file here
+    std::remove(path.c_str());
+#endif
+    if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+        std::remove(temporary.c_str());
+        return false;
+    }
+    return true;
+}
+
+std::shared_ptr<uint8_t[]> mapTableFile(const std::string& path, const TableFileInfo& info, bool verify) {
+    size_t bytes = tableFileBytes(info);
+    std::shared_ptr<const uint8_t> file = mapFile(path, HEADER_BYTES + bytes);
+    if (!file) return nullptr;
+
+    Header header;
+    std::memcpy(&header, file.get(), sizeof(header));
+    if (!matches(header, info)) return nullptr;
+    const uint8_t* entries = file.get() + HEADER_BYTES;
+    if (verify && checksum(entries, bytes) != header.checksum) return nullptr;
+
+    // Shares ownership of the mapping; the tables never write through it
+    return std::shared_ptr<uint8_t[]>(file, const_cast<uint8_t*>(entries));
+}
+
+std::string tableDirectory() {
+    const char* directory = std::getenv("CUBE_TABLE_DIR");
+    return directory && *directory ? directory : "tables";
+}
+
+bool useSharedTables() {
+    const char* shared = std::getenv("CUBE_SHARED_TABLES");
+    return shared && *shared && std::strcmp(shared, "0") != 0;
+}
+
+std::shared_ptr<uint8_t[]> sharedTable(const std::string& name, const TableFileInfo& info,
+                                       const std::function<bool(uint8_t*)>& fill) {
+#ifdef _WIN32
+    (void)name;
+    (void)info;
+    (void)fill;
+    return nullptr;
+#else
+    std::string segment = "/cubetbl-" + name;
+    size_t bytes = tableFileBytes(info), size = HEADER_BYTES + bytes;
+
+    // Held while the segment is checked and, if need be, filled; whoever
+    // comes later blocks here until the table is ready
+    const char* temporary = std::getenv("TMPDIR");
+    std::string lockPath = std::string(temporary && *temporary ? temporary : "/tmp") + segment + ".lock";
+    int lock = open(lockPath.c_str(), O_RDWR | O_CREAT, 0666);
+    if (lock < 0) return nullptr;
+    if (flock(lock, LOCK_EX) != 0) {
+        close(lock);
+        return nullptr;
+    }
+
+    std::shared_ptr<const uint8_t> view;
+    int fd = shm_open(segment.c_str(), O_RDONLY, 0);
+    if (fd >= 0) {
+        // The header is written last, so a matching one means the table is
+        // complete; a filler that died halfway left none
+        view = mapDescriptor(fd, size);
+        if (view && !matches(*reinterpret_cast<const Header*>(view.get()), info)) view = nullptr;
+        close(fd);
+        // A stale segment (older format, other coordinates) may still be
+        // mapped by processes started before the change. Resizing it under
+        // them would fault their reads, so it is unlinked instead: they keep
+        // the old pages and the table is built in a new segment.
+        if (!view) shm_unlink(segment.c_str());
+    }
+
+    if (!view) {
+        fd = shm_open(segment.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+        if (fd >= 0) {
+            if (ftruncate(fd, (off_t)size) == 0) {
+                void* writable = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+                if (writable != MAP_FAILED) {
+                    uint8_t* segmentBytes = static_cast<uint8_t*>(writable);
+                    if (useHugePages()) adviseHugePages(writable, size);
+                    std::memset(segmentBytes, 0, HEADER_BYTES);
+                    if (fill(segmentBytes + HEADER_BYTES)) {
+                        Header header = makeHeader(info, segmentBytes + HEADER_BYTES);
+                        std::memcpy(segmentBytes, &header, sizeof(header));
+                        view = mapDescriptor(fd, size);
+                    } else {
+                        shm_unlink(segment.c_str());
+                    }
+                    munmap(writable, size);
+                }
+            }
+            close(fd);
+        }
+    }
+    flock(lock, LOCK_UN);
+    close(lock);
+
+    if (!view) return nullptr;
+    return std::shared_ptr<uint8_t[]>(view, const_cast<uint8_t*>(view.get() + HEADER_BYTES));
+#endif
+}
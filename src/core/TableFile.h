@@ -0,0 +1,69 @@
+#ifndef CUBECORE_TABLEFILE_H
+#define CUBECORE_TABLEFILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+// Pruning tables on disk, so a solver can start from a file instead of
+// generating its tables. A file is a header page followed by the packed
+// entries exactly as PruningTable or Mod3PruningTable hold them:
+//   magic, format version
+//   bits per entry (4 exact, 2 mod 3), states, goal index, move count
+//   coordinate   how a state maps to its index
+//   generator    what built the table
+//   checksum     of the entries
+// Loading maps the file read-only and uses the entries in place, so startup
+// costs no generation and no copy, and every process using the file shares
+// the same page cache. A file is only accepted if everything in the header
+// matches what the caller expects; anything else (an older format, other
+// coordinates, a truncated or corrupted file) counts as missing.
+
+constexpr uint32_t TABLE_FILE_VERSION = 1;
+
+struct TableFileInfo {
+    std::string coordinate;  // e.g. "cornerPerm * 2187 + twist"; up to 63 characters
+    std::string generator;   // informational, not checked when loading
+    uint32_t bitsPerEntry = 4;
+    uint64_t states = 0;
+    uint64_t goal = 0;
+    uint32_t moveCount = 0;
+};
+
+// Packed size of info.states entries
+size_t tableFileBytes(const TableFileInfo& info);
+
+// Writes the header and entries (tableFileBytes(info) of them) to a
+// temporary file next to path and renames it into place, so a reader never
+// sees a partly written table. False on any I/O error.
+bool writeTableFile(const std::string& path, const TableFileInfo& info, const uint8_t* entries);
+
+// The entries of the table file at path, mapped read-only and unmapped with
+// the last copy of the pointer; null unless the file matches info. With
+// verify the checksum is checked too, which reads the whole file once.
+std::shared_ptr<uint8_t[]> mapTableFile(const std::string& path, const TableFileInfo& info, bool verify = true);
+
+// Directory the solvers keep their table files in: $CUBE_TABLE_DIR, or
+// "tables" under the working directory
+std::string tableDirectory();
+
+// Tables shared between the solver processes on one host: a named POSIX
+// shared memory segment per table (/dev/shm/cubetbl-<name> on Linux),
+// laid out like a table file. The first process to attach calls fill with
+// the segment's entries (tableFileBytes(info) of them) and writes the
+// header after it, unless fill returns false (say, it was cancelled), which
+// removes the segment and returns null; the others wait on a lock file in $TMPDIR meanwhile and
+// then map the finished table read-only. Segments outlive the processes,
+// so a restarted solver attaches without loading anything; one that does
+// not match info is unlinked and replaced by a new segment, so processes
+// still mapping the old one are not disturbed. Null where shared memory is
+// unavailable (Windows), so callers fall back to their own copy.
+std::shared_ptr<uint8_t[]> sharedTable(const std::string& name, const TableFileInfo& info,
+                                       const std::function<bool(uint8_t*)>& fill);
+
+// Whether the solvers use sharedTable: set $CUBE_SHARED_TABLES to 1
+bool useSharedTables();
+
+#endif // CUBECORE_TABLEFILE_H
@@ -0,0 +1,134 @@
+#ifndef CUBECORE_TABLEGENERATOR_H
+#define CUBECORE_TABLEGENERATOR_H
+
+#include "Bits.h"
+#include "PruningTable.h"
+#include "WorkStealingPool.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Multi-threaded breadth-first generation of a Mod3PruningTable, for tables
+// too big to build on one core in reasonable time. Besides the table (2
+// bits per entry) it keeps three bitsets: every state reached so far, the
+// current frontier and the next one. Frontier bits are found a 64-bit word
+// at a time, and the index range is cut into blocks of whole words that the
+// pool's threads take in turn:
+//   forward   each frontier state marks its unvisited neighbors; claims
+//             race between threads, so the shared bitsets are atomic
+//   backward  once more than half the states are reached, each unvisited
+//             state looks for a neighbor in the frontier instead, writing
+//             only its own block
+// Table entries are written block by block after each level, so no two
+// threads ever touch the same byte of the table. The result is identical to
+// Mod3PruningTable::generate.
+class TableGenerator {
+public:
+    // threads as in WorkStealingPool (0 for one per hardware thread)
+    explicit TableGenerator(int threads = 0) : pool(threads) {}
+
+    int threads() const { return pool.size(); }
+
+    // States found at each depth of the last generate()
+    const std::vector<size_t>& levelCounts() const { return levels; }
+
+    // Setting *cancel stops generation within a block of states and makes
+    // it return false, leaving the table incomplete
+    template <class Next>
+    bool generate(Mod3PruningTable& table, size_t goal, int moveCount, Next next,
+                  const std::atomic<bool>* cancel = nullptr);
+
+private:
+    static constexpr size_t BLOCK_WORDS = 1024;  // 65536 states per block
+
+    WorkStealingPool pool;
+    std::vector<size_t> levels;
+};
+
+template <class Next>
+bool TableGenerator::generate(Mod3PruningTable& table, size_t goal, int moveCount, Next next,
+                              const std::atomic<bool>* cancel) {
+    const size_t count = table.size();
+    const size_t words = (count + 63) / 64;
+    const size_t blocks = (words + BLOCK_WORDS - 1) / BLOCK_WORDS;
+    auto makeBits = [&] {
+        std::unique_ptr<std::atomic<uint64_t>[]> bits(new std::atomic<uint64_t>[words]);
+        for (size_t w = 0; w < words; w++) bits[w].store(0, std::memory_order_relaxed);
+        return bits;
+    };
+    auto visited = makeBits(), frontier = makeBits(), following = makeBits();
+    // Bits past the last state count as visited, so they are never claimed
+    if (count % 64 != 0) visited[words - 1] = ~0ull << (count % 64);
+
+    table.set(goal, 0);
+    visited[goal / 64] |= 1ull << (goal % 64);
+    frontier[goal / 64] |= 1ull << (goal % 64);
+    levels.assign(1, 1);
+    size_t reached = 1;
+
+    for (int depth = 0; reached < count; depth++) {
+        bool backward = reached > count / 2;
+        std::atomic<size_t> found{0};
+
+        pool.run(blocks, [&](size_t block) {
+            if (cancel && *cancel) return;
+            size_t first = block * BLOCK_WORDS, last = std::min(words, first + BLOCK_WORDS);
+            size_t claimed = 0;
+            for (size_t w = first; w < last; w++) {
+                if (backward) {
+                    uint64_t open = ~visited[w].load(std::memory_order_relaxed), reachedNow = 0;
+                    for (; open; open &= open - 1) {
+                        size_t i = w * 64 + countTrailingZeros(open);
+                        for (int m = 0; m < moveCount; m++) {
+                            size_t j = next(i, m);
+                            if (frontier[j / 64].load(std::memory_order_relaxed) >> (j % 64) & 1) {
+                                reachedNow |= open & -open;
+                                break;
+                            }
+                        }
+                    }
+                    if (reachedNow) {
+                        following[w].store(reachedNow, std::memory_order_relaxed);
+                        visited[w].fetch_or(reachedNow, std::memory_order_relaxed);
+                        claimed += popcount(reachedNow);
+                    }
+                } else {
+                    for (uint64_t bits = frontier[w].load(std::memory_order_relaxed); bits; bits &= bits - 1) {
+                        size_t i = w * 64 + countTrailingZeros(bits);
+                        for (int m = 0; m < moveCount; m++) {
+                            size_t j = next(i, m);
+                            uint64_t bit = 1ull << (j % 64);
+                            if (visited[j / 64].load(std::memory_order_relaxed) & bit) continue;
+                            if (visited[j / 64].fetch_or(bit, std::memory_order_relaxed) & bit) continue;
+                            following[j / 64].fetch_or(bit, std::memory_order_relaxed);
+                            claimed++;
+                        }
+                    }
+                }
+            }
+            found += claimed;
+        });
+        if (cancel && *cancel) return false;
+        if (found == 0) break;
+
+        // Write the new level and make it the frontier
+        uint8_t value = (depth + 1) % 3;
+        pool.run(blocks, [&](size_t block) {
+            size_t first = block * BLOCK_WORDS, last = std::min(words, first + BLOCK_WORDS);
+            for (size_t w = first; w < last; w++) {
+                uint64_t bits = following[w].load(std::memory_order_relaxed);
+                frontier[w].store(bits, std::memory_order_relaxed);
+                following[w].store(0, std::memory_order_relaxed);
+                for (; bits; bits &= bits - 1) table.set(w * 64 + countTrailingZeros(bits), value);
+            }
+        });
+        levels.push_back(found);
+        reached += found;
+    }
+    return true;
+}
+
+#endif // CUBECORE_TABLEGENERATOR_H
@@ -0,0 +1,369 @@
+#include "ThistlethwaiteSolver.h"
+#include "Bits.h"
+#include "Coordinates.h"
+#include "CubeAlgebra.h"
+#include "PruningTable.h"
+#include "Simplify.h"
+#include "Symmetry.h"
+#include <chrono>
+#include <memory>
+
+// Moves of each phase, the generators of the group it starts in
+static constexpr Move PHASE1_MOVES[18] = {U1, U2, U3, R1, R2, R3, F1, F2, F3,
+                                          D1, D2, D3, L1, L2, L3, B1, B2, B3};
+static constexpr Move PHASE2_MOVES_G1[14] = {U1, U2, U3, D1, D2, D3, R1, R2, R3, L1, L2, L3, F2, B2};
+static constexpr Move PHASE4_MOVES[6] = {U2, D2, R2, F2, L2, B2};
+
+static constexpr int EDGE_PATTERN_COUNT = 70;    // C(8,4) placements of the M slice edges
+static constexpr int CORNER_CLASS_COUNT = 420;   // 8! / 96
+static constexpr int SQUARES_CORNER_COUNT = 96;  // corner permutations of G3
+static constexpr int PHASE3_COUNT = EDGE_PATTERN_COUNT * CORNER_CLASS_COUNT;
+static constexpr int PHASE4_COUNT = SQUARES_CORNER_COUNT * 24 * 24 * 12;
+
+// Edge slots of the S (UR UL DR DL), M (UF UB DF DB) and E (FR FL BL BR)
+// slices; G3 only permutes edges within their slice
+static constexpr uint8_t SLICE_SLOTS[3][4] = {{UR, UL, DR, DL}, {UF, UB, DF, DB}, {FR, FL, BL, BR}};
+static constexpr uint8_t M_SLICE_MASK = (1 << UF) | (1 << UB) | (1 << DF) | (1 << DB);
+
+struct ThistlethwaiteTables {
+    Mod3PruningTable distance[THISTLETHWAITE_PHASES];
+
+    // Phase 1: flip
+    std::vector<std::array<uint16_t, 18>> flipMove;
+    // Phase 2: twist + TWIST_COUNT * slice
+    std::vector<std::array<uint16_t, 14>> twistMove;
+    std::vector<std::array<uint16_t, 14>> sliceMove;
+    // Phase 3: edgePattern + 70 * cornerClass. edgePattern is which U/D
+    // edge slots hold the M slice edges, cornerClass the coset of the corner
+    // permutation under the 96 permutations G3 can make
+    std::array<uint8_t, 256> edgePatternOfMask;
+    std::array<std::array<uint8_t, 10>, EDGE_PATTERN_COUNT> edgePatternMove;
+    std::vector<uint16_t> cornerClassKey;   // smallest corner perm of each class
+    std::array<std::array<uint16_t, 10>, CORNER_CLASS_COUNT> cornerClassMove;
+    // Phase 4: ((squaresCorner * 24 + sPerm) * 24 + mPerm) * 12 + ePerm / 2,
+    // the corners as an index into squaresCornerPerm and the edge order in
+    // each slice; the E slice order is half determined by parity
+    std::vector<uint16_t> squaresCornerPerm;
+    std::array<uint8_t, SQUARES_CORNER_COUNT> squaresCornerParity;
+    std::array<std::array<uint8_t, 6>, SQUARES_CORNER_COUNT> squaresCornerMove;
+    std::array<std::array<std::array<uint8_t, 6>, 24>, 3> slicePermMove;
+};
+
+// --- Helpers ---
+
+// Parity of the permutation with Lehmer rank r (the sum of its digits)
+static int permutationParity4(int rank) {
+    return (rank / 6 + rank / 2 % 3 + rank % 2) & 1;
+}
+
+static int cornerParity(const CubieCube& c) {
+    int parity = 0;
+    for (int i = 0; i < CORNER_COUNT; i++) {
+        for (int j = i + 1; j < CORNER_COUNT; j++) {
+            if (c.cp[j] < c.cp[i]) parity ^= 1;
+        }
+    }
+    return parity;
+}
+
+static int slicePerm(const CubieCube& c, int slice) {
+    uint8_t p[4];
+    for (int k = 0; k < 4; k++) {
+        for (int j = 0; j < 4; j++) {
+            if (c.ep[SLICE_SLOTS[slice][k]] == SLICE_SLOTS[slice][j]) p[k] = j;
+        }
+    }
+    return rankPermutation4(p);
+}
+
+static uint8_t mSliceMask(const CubieCube& c) {
+    uint8_t mask = 0;
+    for (int i = 0; i < 8; i++) {
+        if (M_SLICE_MASK & (1 << c.ep[i])) mask |= 1 << i;
+    }
+    return mask;
+}
+
+static CubieCube cornerPermCube(uint16_t perm) {
+    CubieCube c;
+    unrankCornerPerm(c, perm);
+    return c;
+}
+
+// Smallest rank in the class { h * c : h a G3 corner permutation }
+static uint16_t cornerClassKey(const ThistlethwaiteTables& t, const CubieCube& c) {
+    uint16_t key = CORNER_PERM_COUNT - 1;
+    for (uint16_t h : t.squaresCornerPerm) {
+        CubieCube x = cornerPermCube(h);
+        x.multiply(c);
+        key = std::min(key, rankCornerPerm(x));
+    }
+    return key;
+}
+
+static int phase4Index(int corner, int s, int m, int e) {
+    return ((corner * 24 + s) * 24 + m) * 12 + e / 2;
+}
+
+// --- Tables ---
+
+static void buildPhase1(ThistlethwaiteTables& t) {
+    t.flipMove.resize(FLIP_COUNT);
+    for (int flip = 0; flip < FLIP_COUNT; flip++) {
+        CubieCube c;
+        unrankFlip(c, flip);
+        for (int k = 0; k < 18; k++) {
+            CubieCube d = c;
+            d.applyMove(PHASE1_MOVES[k]);
+            t.flipMove[flip][k] = rankFlip(d);
+        }
+    }
+    t.distance[0] = Mod3PruningTable(FLIP_COUNT);
+    t.distance[0].generate(0, 18, [&](size_t i, int k) { return t.flipMove[i][k]; });
+}
+
+static void buildPhase2(ThistlethwaiteTables& t) {
+    t.twistMove.resize(TWIST_COUNT);
+    for (int twist = 0; twist < TWIST_COUNT; twist++) {
+        CubieCube c;
+        unrankTwist(c, twist);
+        for (int k = 0; k < 14; k++) {
+            CubieCube d = c;
+            d.applyMove(PHASE2_MOVES_G1[k]);
+            t.twistMove[twist][k] = rankTwist(d);
+        }
+    }
+    t.sliceMove.resize(SLICE_COUNT);
+    for (int slice = 0; slice < SLICE_COUNT; slice++) {
+        CubieCube c;
+        unrankSlice(c, slice);
+        for (int k = 0; k < 14; k++) {
+            CubieCube d = c;
+            d.applyMove(PHASE2_MOVES_G1[k]);
+            t.sliceMove[slice][k] = rankSlice(d);
+        }
+    }
+    t.distance[1] = Mod3PruningTable((size_t)TWIST_COUNT * SLICE_COUNT);
+    t.distance[1].generate(0, 14, [&](size_t i, int k) {
+        return t.twistMove[i % TWIST_COUNT][k] + (size_t)TWIST_COUNT * t.sliceMove[i / TWIST_COUNT][k];
+    });
+}
+
+// The corner permutations half turns can make, breadth first from solved;
+// phases 3 and 4 both need them
+static void buildSquaresCorners(ThistlethwaiteTables& t) {
+    std::vector<int8_t> indexOfPerm(CORNER_PERM_COUNT, -1);
+    t.squaresCornerPerm.push_back(0);
+    indexOfPerm[0] = 0;
+    for (size_t k = 0; k < t.squaresCornerPerm.size(); k++) {
+        CubieCube corners = cornerPermCube(t.squaresCornerPerm[k]);
+        t.squaresCornerParity[k] = cornerParity(corners);
+        for (int j = 0; j < 6; j++) {
+            CubieCube c = corners;
+            c.applyMove(PHASE4_MOVES[j]);
+            uint16_t perm = rankCornerPerm(c);
+            if (indexOfPerm[perm] < 0) {
+                indexOfPerm[perm] = t.squaresCornerPerm.size();
+                t.squaresCornerPerm.push_back(perm);
+            }
+            t.squaresCornerMove[k][j] = indexOfPerm[perm];
+        }
+    }
+}
+
+static void buildPhase3(ThistlethwaiteTables& t) {
+    // Edge patterns, numbered so the solved one (M edges in M slots) is 0
+    uint8_t maskOfPattern[EDGE_PATTERN_COUNT];
+    t.edgePatternOfMask.fill(0);
+    int patterns = 0;
+    maskOfPattern[patterns++] = M_SLICE_MASK;
+    for (int mask = 0; mask < 256; mask++) {
+        if (popcount(mask) == 4 && mask != M_SLICE_MASK) maskOfPattern[patterns++] = mask;
+    }
+    for (int p = 0; p < EDGE_PATTERN_COUNT; p++) t.edgePatternOfMask[maskOfPattern[p]] = p;
+    for (int p = 0; p < EDGE_PATTERN_COUNT; p++) {
+        for (int k = 0; k < PHASE2_MOVE_COUNT; k++) {
+            // The edge in slot move.ep[i] goes to slot i
+            const CubieCube& move = MOVE_CUBES[PHASE2_MOVES[k]];
+            uint8_t mask = 0;
+            for (int i = 0; i < 8; i++) {
+                if (maskOfPattern[p] & (1 << move.ep[i])) mask |= 1 << i;
+            }
+            t.edgePatternMove[p][k] = t.edgePatternOfMask[mask];
+        }
+    }
+
+    // Corner classes, found breadth first from the solved one
+    std::vector<int16_t> classOfKey(CORNER_PERM_COUNT, -1);
+    t.cornerClassKey.push_back(0);
+    classOfKey[0] = 0;
+    for (size_t k = 0; k < t.cornerClassKey.size(); k++) {
+        CubieCube representative = cornerPermCube(t.cornerClassKey[k]);
+        for (int j = 0; j < PHASE2_MOVE_COUNT; j++) {
+            CubieCube c = representative;
+            c.applyMove(PHASE2_MOVES[j]);
+            uint16_t key = cornerClassKey(t, c);
+            if (classOfKey[key] < 0) {
+                classOfKey[key] = t.cornerClassKey.size();
+                t.cornerClassKey.push_back(key);
+            }
+            t.cornerClassMove[k][j] = classOfKey[key];
+        }
+    }
+
+    t.distance[2] = Mod3PruningTable(PHASE3_COUNT);
+    t.distance[2].generate(0, PHASE2_MOVE_COUNT, [&](size_t i, int k) {
+        return t.edgePatternMove[i % EDGE_PATTERN_COUNT][k]
+             + (size_t)EDGE_PATTERN_COUNT * t.cornerClassMove[i / EDGE_PATTERN_COUNT][k];
+    });
+}
+
+static void buildPhase4(ThistlethwaiteTables& t) {
+    for (int slice = 0; slice < 3; slice++) {
+        for (int rank = 0; rank < 24; rank++) {
+            // An edge order with that rank: Lehmer digits rank / 6, rank / 2 % 3, rank % 2
+            uint8_t available[4] = {0, 1, 2, 3}, order[4];
+            int digits[4] = {rank / 6, rank / 2 % 3, rank % 2, 0};
+            for (int i = 0; i < 4; i++) {
+                order[i] = available[digits[i]];
+                for (int j = digits[i]; j < 3 - i; j++) available[j] = available[j + 1];
+            }
+            CubieCube c;
+            for (int i = 0; i < 4; i++) c.ep[SLICE_SLOTS[slice][i]] = SLICE_SLOTS[slice][order[i]];
+            for (int j = 0; j < 6; j++) {
+                CubieCube d = c;
+                d.applyMove(PHASE4_MOVES[j]);
+                t.slicePermMove[slice][rank][j] = slicePerm(d, slice);
+            }
+        }
+    }
+
+    t.distance[3] = Mod3PruningTable(PHASE4_COUNT);
+    t.distance[3].generate(0, 6, [&](size_t i, int k) {
+        int e = i % 12 * 2, m = i / 12 % 24, s = i / (12 * 24) % 24, corner = i / (12 * 24 * 24);
+        // Edge and corner parity agree, which fixes the last bit of the E order
+        int parity = t.squaresCornerParity[corner] ^ permutationParity4(s) ^ permutationParity4(m);
+        e += parity ^ permutationParity4(e);
+        return phase4Index(t.squaresCornerMove[corner][k], t.slicePermMove[0][s][k],
+                           t.slicePermMove[1][m][k], t.slicePermMove[2][e][k]);
+    });
+}
+
+static std::unique_ptr<ThistlethwaiteTables> buildTables() {
+    auto tables = std::make_unique<ThistlethwaiteTables>();
+    buildPhase1(*tables);
+    buildPhase2(*tables);
+    buildSquaresCorners(*tables);
+    buildPhase3(*tables);
+    buildPhase4(*tables);
+    return tables;
+}
+
+const ThistlethwaiteTables& thistlethwaiteTables() {
+    static const std::unique_ptr<ThistlethwaiteTables> tables = buildTables();
+    return *tables;
+}
+
+size_t thistlethwaiteTableBytes() {
+    const ThistlethwaiteTables& t = thistlethwaiteTables();
+    size_t bytes = sizeof(ThistlethwaiteTables);
+    for (const Mod3PruningTable& table : t.distance) bytes += table.bytes();
+    bytes += t.flipMove.size() * sizeof(t.flipMove[0]);
+    bytes += t.twistMove.size() * sizeof(t.twistMove[0]) + t.sliceMove.size() * sizeof(t.sliceMove[0]);
+    bytes += (t.cornerClassKey.size() + t.squaresCornerPerm.size()) * sizeof(uint16_t);
+    return bytes;
+}
+
+// --- Solver ---
+
+// Walks the distance table from index to the goal (index 0), one move
+// closer each step. Returns false if no neighbor is closer, which only an
+// index outside the phase's coset space can cause.
+template <class Next>
+static bool descend(const Mod3PruningTable& table, size_t index, const Move* moves, int moveCount,
+                    Next next, std::vector<Move>& solution) {
+    while (index != 0) {
+        uint8_t closer = (table.get(index) + 2) % 3;
+        bool stepped = false;
+        for (int k = 0; k < moveCount && !stepped; k++) {
+            size_t neighbor = next(index, k);
+            if (table.get(neighbor) == closer) {
+                solution.push_back(moves[k]);
+                index = neighbor;
+                stepped = true;
+            }
+        }
+        if (!stepped) return false;
+    }
+    return true;
+}
+
+ThistlethwaiteSolver::ThistlethwaiteSolver() : tables(thistlethwaiteTables()) {}
+
+std::vector<Move> ThistlethwaiteSolver::solve(const CubieCube& cube) {
+    auto startTime = std::chrono::steady_clock::now();
+    const ThistlethwaiteTables& t = tables;
+    phaseLengths.fill(0);
+
+    int rotation = centerRotation(cube);
+    CubieCube c = cube;
+    if (rotation != 0) c.multiply(symmetryTables().cubes[rotation]);
+
+    std::vector<Move> solution;
+    bool solved = isSolvable(c);
+    for (int phase = 0; phase < THISTLETHWAITE_PHASES && solved; phase++) {
+        size_t first = solution.size();
+        switch (phase) {
+            case 0:
+                solved = descend(t.distance[0], rankFlip(c), PHASE1_MOVES, 18,
+                                 [&](size_t i, int k) { return t.flipMove[i][k]; }, solution);
+                break;
+            case 1:
+                solved = descend(t.distance[1], rankTwist(c) + (size_t)TWIST_COUNT * rankSlice(c),
+                                 PHASE2_MOVES_G1, 14, [&](size_t i, int k) {
+                    return t.twistMove[i % TWIST_COUNT][k]
+                         + (size_t)TWIST_COUNT * t.sliceMove[i / TWIST_COUNT][k];
+                }, solution);
+                break;
+            case 2: {
+                uint16_t key = cornerClassKey(t, c);
+                size_t cornerClass = 0;
+                while (t.cornerClassKey[cornerClass] != key) cornerClass++;
+                size_t index = t.edgePatternOfMask[mSliceMask(c)] + EDGE_PATTERN_COUNT * cornerClass;
+                solved = descend(t.distance[2], index, PHASE2_MOVES, PHASE2_MOVE_COUNT, [&](size_t i, int k) {
+                    return t.edgePatternMove[i % EDGE_PATTERN_COUNT][k]
+                         + (size_t)EDGE_PATTERN_COUNT * t.cornerClassMove[i / EDGE_PATTERN_COUNT][k];
+                }, solution);
+                break;
+            }
+            case 3: {
+                uint16_t perm = rankCornerPerm(c);
+                int corner = 0;
+                while (t.squaresCornerPerm[corner] != perm) corner++;
+                size_t index = phase4Index(corner, slicePerm(c, 0), slicePerm(c, 1), slicePerm(c, 2));
+                solved = descend(t.distance[3], index, PHASE4_MOVES, 6, [&](size_t i, int k) {
+                    int e = i % 12 * 2, m = i / 12 % 24, s = i / (12 * 24) % 24, corner = i / (12 * 24 * 24);
+                    int parity = t.squaresCornerParity[corner] ^ permutationParity4(s) ^ permutationParity4(m);
+                    e += parity ^ permutationParity4(e);
+                    return phase4Index(t.squaresCornerMove[corner][k], t.slicePermMove[0][s][k],
+                                       t.slicePermMove[1][m][k], t.slicePermMove[2][e][k]);
+                }, solution);
+                break;
+            }
+        }
+        for (size_t i = first; i < solution.size(); i++) c.applyMove(solution[i]);
+        phaseLengths[phase] = solution.size() - first;
+    }
+    if (!solved) solution.clear();
+
+    if (rotation != 0) {
+        const SymmetryTables& sym = symmetryTables();
+        for (Move& m : solution) m = sym.moveConjugate[sym.inverse[rotation]][m];
+    }
+
+    // Turns on one axis that meet at a phase boundary merge; face turns in,
+    // face turns out
+    std::vector<Move> folded = simplifyMoves(solution);
+    microseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - startTime).count();
+    return folded;
+}
@@ -0,0 +1,47 @@
+#ifndef CUBECORE_THISTLETHWAITESOLVER_H
+#define CUBECORE_THISTLETHWAITESOLVER_H
+
+#include "CubieCube.h"
+#include "Move.h"
+#include <array>
+#include <cstddef>
+#include <vector>
+
+// Thistlethwaite's algorithm: four phases, each moving the cube into a
+// smaller subgroup with the moves of the current one,
+//   G0 = <U, D, R, L, F, B>
+//   G1 = <U, D, R, L, F2, B2>      edges oriented
+//   G2 = <U, D, R2, L2, F2, B2>    corners oriented, slice edges in the slice
+//   G3 = <U2, D2, R2, L2, F2, B2>  corners in their tetrads, edges in their slices
+// and then solved. Each phase has a complete distance table over its coset
+// space stored mod 3, so a phase is solved by stepping to a neighbor one
+// move closer until the goal is reached, with no search at all. Solutions
+// are typically 30-45 moves.
+
+constexpr int THISTLETHWAITE_PHASES = 4;
+
+// Distance tables and the small coordinate move tables that walk them,
+// about 600 KB together, built on first use
+struct ThistlethwaiteTables;
+const ThistlethwaiteTables& thistlethwaiteTables();
+size_t thistlethwaiteTableBytes();
+
+class ThistlethwaiteSolver {
+public:
+    ThistlethwaiteSolver();
+
+    // Face moves that solve the cube (up to a whole-cube rotation when slice
+    // turns moved the centers); empty when solved or unsolvable
+    std::vector<Move> solve(const CubieCube& cube);
+
+    // Statistics of the last solve
+    const std::array<int, THISTLETHWAITE_PHASES>& getPhaseLengths() const { return phaseLengths; }
+    double getMicroseconds() const { return microseconds; }
+
+private:
+    const ThistlethwaiteTables& tables;
+    std::array<int, THISTLETHWAITE_PHASES> phaseLengths{};
+    double microseconds = 0;
+};
+
+#endif // CUBECORE_THISTLETHWAITESOLVER_H
@@ -0,0 +1,265 @@
+#include "TwoPhaseSolver.h"
+#include "CubeAlgebra.h"
+#include "Symmetry.h"
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+// --- Tables ---
+
+static std::unique_ptr<TwoPhaseTables> buildTables() {
+    const CoordinateTables& t = coordinateTables();
+    auto tables = std::make_unique<TwoPhaseTables>();
+
+    tables->twistSlice = PruningTable((size_t)TWIST_COUNT * SLICE_COUNT);
+    tables->twistSlice.generate(0, FACE_MOVE_COUNT, [&](size_t i, int m) {
+        size_t twist = i % TWIST_COUNT, slice = i / TWIST_COUNT;
+        return t.twistMove[twist][m] + (size_t)TWIST_COUNT * t.sliceMove(slice, Move(m));
+    });
+
+    const SymmetryClasses& flipSlice = tables->flipSlice;
+    tables->flipSliceClass = PruningTable(FLIPSLICE_CLASS_COUNT);
+    tables->flipSliceClass.generate(0, FACE_MOVE_COUNT, [&](size_t cls, int m) {
+        uint32_t x = flipSlice.representative[cls];
+        size_t flip = x % FLIP_COUNT, slice = x / FLIP_COUNT;
+        return flipSlice.classOf[t.flipMove[flip][m] + (size_t)FLIP_COUNT * t.sliceMove(slice, Move(m))];
+    });
+
+    const SymmetryTables& sym = symmetryTables();
+    for (int p = 0; p < SLICE_PERM_COUNT; p++) {
+        CubieCube c;
+        unrankSlicePerm(c, p);
+        for (int s = 0; s < UD_SYMMETRY_COUNT; s++) {
+            tables->slicePermToClass[p][s] = rankSlicePerm(symConjugate(c, sym.inverse[s]));
+        }
+    }
+    // A representative with self-symmetries stands for a position in more
+    // than one way: with a slice permutation, or with it conjugated by any of
+    // them. Searching over all of those would miss edges, so the search runs
+    // over the smallest of each set and the others are copied from it.
+    const SymmetryClasses& cornerPerm = tables->cornerPerm;
+    auto canonical = [&](size_t i) {
+        size_t cls = i % CORNER_PERM_CLASS_COUNT, slicePerm = i / CORNER_PERM_CLASS_COUNT, smallest = slicePerm;
+        for (int s = 1; s < UD_SYMMETRY_COUNT; s++) {
+            if (cornerPerm.selfSymmetry[cls] & (1 << s)) {
+                smallest = std::min<size_t>(smallest, tables->slicePermToClass[slicePerm][s]);
+            }
+        }
+        return cls + (size_t)CORNER_PERM_CLASS_COUNT * smallest;
+    };
+    PruningTable& cornerTable = tables->cornerClassSlicePerm;
+    cornerTable = PruningTable((size_t)CORNER_PERM_CLASS_COUNT * SLICE_PERM_COUNT);
+    cornerTable.generate(0, PHASE2_MOVE_COUNT, [&](size_t i, int k) {
+        size_t cls = i % CORNER_PERM_CLASS_COUNT, slicePerm = i / CORNER_PERM_CLASS_COUNT;
+        return canonical(tables->cornerClassIndex(t.cornerPermMove[cornerPerm.representative[cls]][PHASE2_MOVES[k]],
+                                                  t.slicePermMove[slicePerm][k]));
+    });
+    for (size_t i = 0; i < cornerTable.size(); i++) cornerTable.set(i, cornerTable.get(canonical(i)));
+
+    tables->edgeSlicePerm = PruningTable((size_t)UD_EDGE_PERM_COUNT * SLICE_PERM_COUNT);
+    tables->edgeSlicePerm.generate(0, PHASE2_MOVE_COUNT, [&](size_t i, int k) {
+        size_t perm = i % UD_EDGE_PERM_COUNT, slicePerm = i / UD_EDGE_PERM_COUNT;
+        return t.udEdgePermMove[perm][k]
+             + (size_t)UD_EDGE_PERM_COUNT * t.slicePermMove[slicePerm][k];
+    });
+
+    return tables;
+}
+
+const TwoPhaseTables& twoPhaseTables() {
+    static const std::unique_ptr<TwoPhaseTables> tables = buildTables();
+    return *tables;
+}
+
+// --- Solver ---
+
+TwoPhaseSolver::TwoPhaseSolver(TwoPhaseOptions options)
+    : options(options), coords(coordinateTables()), tables(twoPhaseTables()) {}
+
+std::vector<Move> TwoPhaseSolver::solve(const CubieCube& cube) {
+    startTime = std::chrono::steady_clock::now();
+    nodes = 0;
+    path.clear();
+    best.clear();
+    bestLength = options.maxLength + 1;
+    done = false;
+
+    // Rotate the whole cube so its centers are home: solve cube * R, then
+    // turn each move m of that solution into R m R^-1
+    rotation = centerRotation(cube);
+    start = cube;
+    if (rotation != 0) start.multiply(symmetryTables().cubes[rotation]);
+
+    if (isSolvable(start) && options.race) {
+        race();
+    } else if (isSolvable(start)) {
+        uint16_t twist = rankTwist(start), flip = rankFlip(start), slice = rankSlice(start);
+        int estimate = std::max(tables.twistSlice.get(twist + (size_t)TWIST_COUNT * slice),
+                                tables.flipSliceDistance(flip, slice));
+        for (int depth1 = estimate; depth1 < bestLength && !done; depth1++) {
+            searchPhase1(twist, flip, slice, depth1);
+        }
+    }
+
+    milliseconds = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - startTime).count();
+    return unrotated(best);
+}
+
+// Six searches on their own threads: the cube seen from each of the three
+// axes (conjugated by URF3^k), and its inverse from each. Every solution is
+// mapped back to the cube; the shortest wins, and the first one within
+// targetLength stops all six.
+void TwoPhaseSolver::race() {
+    const SymmetryTables& sym = symmetryTables();
+    std::atomic<bool> finished{false};
+    std::mutex mutex;
+    std::vector<std::thread> threads;
+    for (int variant = 0; variant < 6; variant++) {
+        threads.emplace_back([&, variant] {
+            int s = 16 * (variant % 3);
+            bool inverted = variant >= 3;
+            auto toStart = [&](std::vector<Move> moves) {
+                for (Move& m : moves) m = sym.moveConjugate[sym.inverse[s]][m];
+                if (inverted) {
+                    std::reverse(moves.begin(), moves.end());
+                    for (Move& m : moves) m = inverseMove(m);
+                }
+                return moves;
+            };
+
+            TwoPhaseOptions variantOptions = options;
+            variantOptions.race = false;
+            variantOptions.onImprovement = [&](const std::vector<Move>& moves) {
+                std::vector<Move> solution = toStart(moves);
+                std::lock_guard<std::mutex> lock(mutex);
+                if ((int)solution.size() >= bestLength) return;
+                best = solution;
+                bestLength = best.size();
+                if (bestLength <= options.targetLength) finished = true;
+                if (options.onImprovement) options.onImprovement(unrotated(best));
+            };
+            TwoPhaseSolver solver(variantOptions);
+            solver.raceFinished = &finished;
+            solver.solve(symConjugate(inverted ? inverse(start) : start, s));
+
+            std::lock_guard<std::mutex> lock(mutex);
+            nodes += solver.nodes;
+        });
+    }
+    for (std::thread& t : threads) t.join();
+}
+
+// Moves found for start, as moves for the cube passed to solve()
+std::vector<Move> TwoPhaseSolver::unrotated(std::vector<Move> moves) const {
+    if (rotation != 0) {
+        const SymmetryTables& sym = symmetryTables();
+        for (Move& m : moves) m = sym.moveConjugate[sym.inverse[rotation]][m];
+    }
+    return moves;
+}
+
+bool TwoPhaseSolver::cancelled() const {
+    return (options.cancel && *options.cancel) || (raceFinished && *raceFinished);
+}
+
+bool TwoPhaseSolver::timeUp() const {
+    return std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - startTime).count() > options.timeLimitMs;
+}
+
+bool TwoPhaseSolver::searchPhase1(uint16_t twist, uint16_t flip, uint16_t slice, int depth) {
+    if (depth == 0) {
+        // A phase 1 ending in a phase 2 move was already tried one move shorter
+        if (!path.empty()) {
+            Move last = path.back();
+            int face = moveFace(last);
+            if (face == 0 || face == 3 || movePower(last) == 2) return false;
+        }
+        startPhase2();
+        return done;
+    }
+
+    for (int i = 0; i < FACE_MOVE_COUNT; i++) {
+        Move m = Move(i);
+        if (!path.empty() && isRedundantAfter(path.back(), m)) continue;
+
+        uint16_t newTwist = coords.twistMove[twist][m];
+        uint16_t newFlip = coords.flipMove[flip][m];
+        uint16_t newSlice = coords.sliceMove(slice, m);
+        int estimate = std::max(tables.twistSlice.get(newTwist + (size_t)TWIST_COUNT * newSlice),
+                                tables.flipSliceDistance(newFlip, newSlice));
+        if (estimate > depth - 1) continue;
+
+        if ((++nodes & 0x3ff) == 0 && (cancelled() || (bestLength <= options.maxLength && timeUp()))) {
+            done = true;
+            return true;
+        }
+        path.push_back(m);
+        bool finished = searchPhase1(newTwist, newFlip, newSlice, depth - 1);
+        path.pop_back();
+        if (finished) return true;
+    }
+    return false;
+}
+
+void TwoPhaseSolver::startPhase2() {
+    CubieCube c = start;
+    for (Move m : path) c.applyMove(m);
+    uint16_t cornerPerm = rankCornerPerm(c);
+    uint16_t edgePerm = rankUDEdgePerm(c);
+    uint8_t slicePerm = rankSlicePerm(c);
+
+    phase1Length = path.size();
+    int budget = bestLength - 1 - phase1Length;
+    int estimate = std::max(
+        tables.cornerSlicePermDistance(cornerPerm, slicePerm),
+        tables.edgeSlicePerm.get(edgePerm + (size_t)UD_EDGE_PERM_COUNT * slicePerm));
+
+    for (int depth2 = estimate; depth2 <= budget; depth2++) {
+        if (searchPhase2(cornerPerm, edgePerm, slicePerm, depth2)) {
+            best = path;
+            // A half turn may follow the last phase 1 quarter turn of its face
+            // (R then R2); fold the two into one move
+            if (phase1Length > 0 && (int)best.size() > phase1Length
+                && moveFace(best[phase1Length - 1]) == moveFace(best[phase1Length])) {
+                Move& last = best[phase1Length - 1];
+                last = makeMove(moveFace(last), (movePower(last) + movePower(best[phase1Length])) % 4);
+                best.erase(best.begin() + phase1Length);
+            }
+            bestLength = best.size();
+            path.resize(phase1Length);
+            if (bestLength <= options.targetLength) done = true;
+            if (options.onImprovement) options.onImprovement(unrotated(best));
+            break;
+        }
+    }
+    if (cancelled() || (bestLength <= options.maxLength && timeUp())) done = true;
+}
+
+bool TwoPhaseSolver::searchPhase2(uint16_t cornerPerm, uint16_t edgePerm, uint8_t slicePerm, int depth) {
+    if (depth == 0) return cornerPerm == 0 && edgePerm == 0 && slicePerm == 0;
+
+    for (int k = 0; k < PHASE2_MOVE_COUNT; k++) {
+        Move m = PHASE2_MOVES[k];
+        if (!path.empty()) {
+            bool junction = (int)path.size() == phase1Length;
+            if (junction ? moveFace(m) == moveFace(path.back()) - 3 : isRedundantAfter(path.back(), m)) continue;
+        }
+
+        uint16_t newCornerPerm = coords.cornerPermMove[cornerPerm][m];
+        uint16_t newEdgePerm = coords.udEdgePermMove[edgePerm][k];
+        uint8_t newSlicePerm = coords.slicePermMove[slicePerm][k];
+        int estimate = std::max(
+            tables.cornerSlicePermDistance(newCornerPerm, newSlicePerm),
+            tables.edgeSlicePerm.get(newEdgePerm + (size_t)UD_EDGE_PERM_COUNT * newSlicePerm));
+        if (estimate > depth - 1) continue;
+
+        nodes++;
+        path.push_back(m);
+        if (searchPhase2(newCornerPerm, newEdgePerm, newSlicePerm, depth - 1)) return true;
+        path.pop_back();
+    }
+    return false;
+}
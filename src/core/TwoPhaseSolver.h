@@ -0,0 +1,119 @@
+#ifndef CUBECORE_TWOPHASESOLVER_H
+#define CUBECORE_TWOPHASESOLVER_H
+
+#include "Coordinates.h"
+#include "CubieCube.h"
+#include "Move.h"
+#include "PruningTable.h"
+#include "Symmetry.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// Kociemba's two-phase algorithm. Phase 1 brings the cube into the subgroup
+// <U, D, R2, F2, L2, B2> (no twist, no flip, slice edges in the slice),
+// phase 2 solves it with those moves only. Every phase 1 solution found by
+// iterative deepening is extended with the shortest phase 2 that still beats
+// the best total so far, until a solution is short enough or time runs out.
+//
+// Which solutions the search reaches first depends on the axis it runs
+// from, so with race set six searches run concurrently: the cube
+// conjugated to each axis, and its inverse likewise (a solution of the
+// inverse, reversed and inverted, solves the cube). The first to find a
+// solution within targetLength cancels the others.
+
+// Pruning tables over coordinate pairs, built on first use. Positions that
+// are UD symmetric (see Symmetry.h) are the same distance from the phase
+// goals, so two tables keep one entry per symmetry class: flip x slice
+// (64430 entries instead of 1013760) and corner permutation x slice
+// permutation (66432 instead of 967680), the slice permutation conjugated
+// along with the corners onto their class representative. Together about
+// 1.1 MB, plus the classes (3 MB, most of it the flipslice class index).
+struct TwoPhaseTables {
+    PruningTable twistSlice;           // twist + TWIST_COUNT * slice
+    PruningTable flipSliceClass;       // flipSliceClasses().classOf[flip + FLIP_COUNT * slice]
+    PruningTable cornerClassSlicePerm; // cornerPerm class + CORNER_PERM_CLASS_COUNT * conjugated slicePerm
+    PruningTable edgeSlicePerm;        // udEdgePerm + UD_EDGE_PERM_COUNT * slicePerm
+    // slicePerm of symConjugate(a cube with that slicePerm, inverse[s]):
+    // conjugated the way a corner permutation with symOf s is taken to its
+    // class representative
+    uint8_t slicePermToClass[SLICE_PERM_COUNT][UD_SYMMETRY_COUNT];
+    const SymmetryClasses& flipSlice;
+    const SymmetryClasses& cornerPerm;
+
+    TwoPhaseTables() : flipSlice(flipSliceClasses()), cornerPerm(cornerPermClasses()) {}
+
+    uint8_t flipSliceDistance(uint16_t flip, uint16_t slice) const {
+        return flipSliceClass.get(flipSlice.classOf[flip + (size_t)FLIP_COUNT * slice]);
+    }
+    uint8_t cornerSlicePermDistance(uint16_t cornerPerm, uint8_t slicePerm) const {
+        return cornerClassSlicePerm.get(cornerClassIndex(cornerPerm, slicePerm));
+    }
+    // The entry of (cornerPerm, slicePerm): both conjugated by the symmetry
+    // that takes cornerPerm to its class representative
+    size_t cornerClassIndex(uint16_t perm, uint8_t slicePerm) const {
+        return cornerPerm.classOf[perm] +
+               (size_t)CORNER_PERM_CLASS_COUNT * slicePermToClass[slicePerm][cornerPerm.symOf[perm]];
+    }
+};
+
+const TwoPhaseTables& twoPhaseTables();
+
+struct TwoPhaseOptions {
+    int targetLength = 21;   // stop at the first solution this short
+    double timeLimitMs = 50; // after that, settle for the best one found
+    int maxLength = 30;      // never return anything longer
+    // Called on the searching thread with every solution shorter than the
+    // ones before, so a caller can use it before the search ends
+    std::function<void(const std::vector<Move>&)> onImprovement;
+    // Setting it ends the search at once, with the best solution so far
+    // (if any)
+    const std::atomic<bool>* cancel = nullptr;
+    // Search from all three axes, for the cube and for its inverse, on six
+    // threads at once; the shortest solution wins
+    bool race = false;
+};
+
+class TwoPhaseSolver {
+public:
+    explicit TwoPhaseSolver(TwoPhaseOptions options = {});
+
+    // Face moves that solve the cube. Centers moved by slice turns are
+    // handled by solving the whole-cube rotation that puts them back, so the
+    // result may leave the cube solved but rotated. Empty when the cube is
+    // already solved or cannot be solved (e.g. a single twisted corner).
+    std::vector<Move> solve(const CubieCube& cube);
+
+    // Statistics of the last solve
+    long getNodes() const { return nodes; }
+    double getMilliseconds() const { return milliseconds; }
+
+private:
+    TwoPhaseOptions options;
+    const CoordinateTables& coords;
+    const TwoPhaseTables& tables;
+
+    CubieCube start;
+    int rotation = 0;
+    const std::atomic<bool>* raceFinished = nullptr;  // another racer reached targetLength
+    std::vector<Move> path;
+    std::vector<Move> best;
+    int phase1Length = 0;
+    int bestLength = 0;
+    bool done = false;
+    long nodes = 0;
+    double milliseconds = 0;
+    std::chrono::steady_clock::time_point startTime;
+
+    bool searchPhase1(uint16_t twist, uint16_t flip, uint16_t slice, int depth);
+    bool searchPhase2(uint16_t cornerPerm, uint16_t edgePerm, uint8_t slicePerm, int depth);
+    void startPhase2();
+    void race();
+    std::vector<Move> unrotated(std::vector<Move> moves) const;
+    bool cancelled() const;
+    bool timeUp() const;
+};
+
+#endif // CUBECORE_TWOPHASESOLVER_H
@@ -0,0 +1,94 @@
+#include "WorkStealingPool.h"
+#include <algorithm>
+
+WorkStealingPool::WorkStealingPool(int threadCount) {
+    if (threadCount <= 0) threadCount = std::max(1u, std::thread::hardware_concurrency());
+    for (int i = 0; i < threadCount; i++) queues.push_back(std::make_unique<Queue>());
+    // Worker 0 is whichever thread calls run()
+    for (int i = 1; i < threadCount; i++) threads.emplace_back(&WorkStealingPool::loop, this, i);
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        quitting = true;
+    }
+    wake.notify_all();
+    for (std::thread& t : threads) t.join();
+}
+
+void WorkStealingPool::run(size_t count, const std::function<void(size_t)>& task) {
+    if (count == 0) return;
+
+    // The batch is set before any task can be taken: a worker still
+    // looking for work from the last batch may pick one up straight away
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        batch = &task;
+        remaining = count;
+    }
+    // Dealt round-robin, so neighbouring (often similar) tasks start on
+    // different workers
+    for (size_t i = 0; i < count; i++) {
+        Queue& q = *queues[i % queues.size()];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        q.tasks.push_back(i);
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        generation++;
+    }
+    wake.notify_all();
+
+    work(0);
+    std::unique_lock<std::mutex> lock(mutex);
+    finished.wait(lock, [&] { return remaining == 0; });
+    batch = nullptr;
+}
+
+// Own queue from the back, then the others from the front
+bool WorkStealingPool::next(int worker, size_t& task) {
+    {
+        Queue& own = *queues[worker];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = own.tasks.back();
+            own.tasks.pop_back();
+            return true;
+        }
+    }
+    for (size_t i = 1; i < queues.size(); i++) {
+        Queue& victim = *queues[(worker + i) % queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = victim.tasks.front();
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkStealingPool::work(int worker) {
+    size_t task;
+    while (next(worker, task)) {
+        (*batch)(task);
+        if (--remaining == 0) {
+            std::lock_guard<std::mutex> lock(mutex);
+            finished.notify_all();
+        }
+    }
+}
+
+void WorkStealingPool::loop(int worker) {
+    size_t seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&] { return quitting || generation != seen; });
+            if (quitting) return;
+            seen = generation;
+        }
+        work(worker);
+    }
+}
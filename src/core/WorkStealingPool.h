@@ -0,0 +1,56 @@
+#ifndef CUBECORE_WORKSTEALINGPOOL_H
+#define CUBECORE_WORKSTEALINGPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Persistent worker threads for batches of independent tasks of very uneven
+// size, such as the subtrees of a search. Each worker takes tasks from the
+// back of its own queue and, once that is empty, steals from the front of
+// the others, so a worker stuck in one huge task leaves the rest of its
+// queue to whoever runs out first.
+class WorkStealingPool {
+public:
+    // threads counts the calling thread, which works on every batch too;
+    // 0 for one per hardware thread
+    explicit WorkStealingPool(int threads = 0);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    int size() const { return (int)queues.size(); }
+
+    // Calls task(i) for every i < count, spread over the workers, and returns
+    // once all calls have finished
+    void run(size_t count, const std::function<void(size_t)>& task);
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<size_t> tasks;
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> threads;
+
+    std::mutex mutex;
+    std::condition_variable wake, finished;
+    const std::function<void(size_t)>* batch = nullptr;
+    size_t generation = 0;
+    std::atomic<size_t> remaining{0};
+    bool quitting = false;
+
+    bool next(int worker, size_t& task);
+    void work(int worker);
+    void loop(int worker);
+};
+
+#endif // CUBECORE_WORKSTEALINGPOOL_H
@@ -1,6 +1,8 @@
 #include "engine.h"
 #include "RubiksCube.h"
-#include "Solver.h"
+#include "core/Solver.h"
+#include <chrono>
+#include <sstream>
 
 Engine::Engine() : cameraZ(-8.0f) {
   if (!initWindow()) {
@@ -14,6 +16,10 @@ Engine::Engine() : cameraZ(-8.0f) {
 }
 
 Engine::~Engine() {
+  // A search still running holds no GL state; stop it (a first table
+  // build included) before tearing down
+  solveCancel = true;
+  if (pendingSolve.valid()) pendingSolve.wait();
   glfwTerminate();
 }
 
@@ -101,8 +107,12 @@ void Engine::processInput() {
             if (key == GLFW_KEY_ESCAPE)
                 glfwSetWindowShouldClose(window, true);
 
+            // A search or solution in progress plans from the state it
+            // started on, so manual turns and scrambles wait for it
+            bool solveInProgress = pendingSolve.valid() || anytimeActive || !solutionMoves.empty();
+
             // Cube moves (only if cube not rotating)
-            if (!rubiksCube->isRotating()) {
+            if (!rubiksCube->isRotating() && !solveInProgress) {
 
                 bool shiftPressed = isShiftPressed();
 
@@ -119,7 +129,7 @@ void Engine::processInput() {
             }
 
             // Scramble
-            if (key == GLFW_KEY_P && !isScrambling && !rubiksCube->isRotating()) {
+            if (key == GLFW_KEY_P && !isScrambling && !rubiksCube->isRotating() && !solveInProgress) {
                 for (int f = 0; f < 20; f++)
                     scrambleMoves.push(rand() % 12);
                 isScrambling = true;
@@ -132,10 +142,34 @@ void Engine::processInput() {
                 testSolverAccess();
             }
 
-            // Auto solve
+            // Auto solve: the selected strategy, or the beginner method with SHIFT
             if (key == GLFW_KEY_SPACE) {
-                if (!cubeSolver) initSolver();
-                startAutoSolve();
+                if (isShiftPressed()) {
+                    if (!cubeSolver) initSolver();
+                    startAutoSolve();
+                } else {
+                    startComputedSolve();
+                }
+            }
+
+            // Cycle the SPACE solver: two-phase, optimal, Thistlethwaite, CFOP,
+            // meet-in-the-middle, anytime
+            if (key == GLFW_KEY_O) {
+                switch (solveStrategy) {
+                    case SolveStrategy::TWO_PHASE:      solveStrategy = SolveStrategy::OPTIMAL;        break;
+                    case SolveStrategy::OPTIMAL:        solveStrategy = SolveStrategy::THISTLETHWAITE; break;
+                    case SolveStrategy::THISTLETHWAITE: solveStrategy = SolveStrategy::CFOP;           break;
+                    case SolveStrategy::CFOP:           solveStrategy = SolveStrategy::BIDIRECTIONAL;  break;
+                    case SolveStrategy::BIDIRECTIONAL:  solveStrategy = SolveStrategy::ANYTIME;        break;
+                    case SolveStrategy::ANYTIME:        solveStrategy = SolveStrategy::TWO_PHASE;      break;
+                }
+                std::cout << "Solve strategy: "
+                          << (solveStrategy == SolveStrategy::OPTIMAL        ? "optimal"
+                            : solveStrategy == SolveStrategy::THISTLETHWAITE ? "Thistlethwaite"
+                            : solveStrategy == SolveStrategy::CFOP           ? "CFOP"
+                            : solveStrategy == SolveStrategy::BIDIRECTIONAL  ? "meet-in-the-middle"
+                            : solveStrategy == SolveStrategy::ANYTIME        ? "anytime"
+                                                                             : "two-phase") << std::endl;
             }
         }
         else if (state == GLFW_RELEASE) {
@@ -184,6 +218,20 @@ void Engine::update() {
        }
   }
 
+    if (pendingSolve.valid()) pollComputedSolve();
+    if (anytimeActive) adoptAnytimeImprovement();
+
+    if (!solutionMoves.empty() && !rubiksCube->isRotating()) {
+        rubiksCube->executeMove(solutionMoves.front());
+        Move m;
+        if (anytimeActive && moveFromString(solutionMoves.front(), m)) anytimePlayed.push_back(m);
+        solutionMoves.pop();
+        if (solutionMoves.empty() && !afterPlayback.empty()) {
+            std::cout << afterPlayback << std::endl;
+            afterPlayback.clear();
+        }
+    }
+
     if (cubeSolver && cubeSolver->isSolving() && !rubiksCube->isRotating()) {
         std::string move = cubeSolver->getNextMove();
 
@@ -192,8 +240,9 @@ void Engine::update() {
             rubiksCube->executeMove(move);
         }
         else if (cubeSolver->getCurrentState() == SOLVING) {
-            // Check if we're actually solved
-            if (rubiksCube->isSolved()) {
+            // Check if we're actually solved; the method may leave the
+            // cube turned as a whole
+            if (rubiksCube->getState().isSolvedUpToRotation()) {
                 std::cout << "Cube solved!" << std::endl;
                 cubeSolver->setState(WCCOMPLETE);
             }
@@ -290,7 +339,7 @@ void Engine::executeRandomMove() {
 
 void Engine::initSolver() {
     if (rubiksCube && !cubeSolver) {
-        cubeSolver = std::make_unique<Solver>(rubiksCube.get());
+        cubeSolver = std::make_unique<Solver>(&rubiksCube->getState());
         std::cout << "Solver Init successful" << std::endl;
         // cubeSolver->testCubeAccess(rubiksCube.get());
     }
@@ -304,13 +353,209 @@ void Engine::testSolverAccess() {
 
 void Engine::startAutoSolve() {
     if (cubeSolver && rubiksCube) {
-        cubeSolver->solve(rubiksCube.get());
+        if (isScrambling || rubiksCube->isRotating() || !solutionMoves.empty() || pendingSolve.valid()) return;
+        // The whole beginner solve is worked out first, then played back
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::string> solution = cubeSolver->computeSolution(rubiksCube->getState());
+        double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        // The solver turns the whole cube with layer moves (R X L') and often
+        // undoes its own turns; none of that needs playing back
+        std::vector<Move> moves;
+        Move m;
+        for (const std::string& move : solution) {
+            if (moveFromString(move, m)) moves.push_back(m);
+        }
+        std::vector<Move> simplified = simplifyMoves(moves, false);
+        if (cubeSolver->isFailed() && simplified.empty()) {
+            std::cout << "Beginner solver stalled in step " << cubeSolver->getCurrentStep() << " after "
+                      << milliseconds << " ms; try SPACE" << std::endl;
+            return;
+        }
+        if (cubeSolver->isFailed()) {
+            // Play what it got through (the cross and F2L, say) and say where it stopped after
+            std::cout << "Beginner solver stalled in step " << cubeSolver->getCurrentStep() << "; playing the "
+                      << simplified.size() << " moves before the stall (" << milliseconds << " ms)" << std::endl;
+            afterPlayback = "Beginner solver stalled in step " + std::to_string(cubeSolver->getCurrentStep()) +
+                            "; try SPACE to finish";
+        } else {
+            std::cout << "Beginner solution (" << simplified.size() << " moves, " << solution.size()
+                      << " before simplifying, " << milliseconds << " ms)" << std::endl;
+        }
+        queueSolution(simplified);
     } else {
         if (!cubeSolver) std::cout << "Solver not initialized" << std::endl;
         if (!rubiksCube) std::cout << "Cube not initialized" << std::endl;
     }
 }
 
+void Engine::startComputedSolve() {
+    if (!rubiksCube || isScrambling || rubiksCube->isRotating() || !solutionMoves.empty()) return;
+    if (pendingSolve.valid()) {
+        std::cout << "Still searching" << std::endl;
+        return;
+    }
+    // A new anytime start waits for the last search; one still winding down
+    // (say, in a table build) would hold up the worker
+    if (solveStrategy == SolveStrategy::ANYTIME && anytime && anytime->isSearching()) {
+        std::cout << "Anytime: the last search is still stopping" << std::endl;
+        return;
+    }
+    CubieCube cube = CubieCube::fromCubeState(rubiksCube->getState());
+
+    std::cout << "Searching..." << std::endl;
+    solveCancel = false;
+    pendingSolve = std::async(std::launch::async, &Engine::searchSolution, this, cube, solveStrategy);
+}
+
+// Runs on the worker thread: touches nothing of the engine but solveCancel
+// and the solvers it creates, and leaves the printing to the render thread
+Engine::ComputedSolve Engine::searchSolution(CubieCube cube, SolveStrategy strategy) {
+    std::ostringstream report;
+
+    // Each solver builds its tables on first use, which takes longer than a frame
+    if (strategy == SolveStrategy::ANYTIME) {
+        // The first solution comes back to be played; the search for shorter
+        // ones goes on on the solver's own thread
+        if (!anytime) anytime = std::make_unique<AnytimeSolver>();
+        std::vector<Move> first = anytime->start(cube);
+        report << "Anytime: playing a " << first.size() << " move solution, searching for shorter ones";
+        return {cube, first, report.str(), true};
+    }
+
+    if (strategy == SolveStrategy::THISTLETHWAITE) {
+        if (!thistlethwaite) thistlethwaite = std::make_unique<ThistlethwaiteSolver>();
+        std::vector<Move> solution = thistlethwaite->solve(cube);
+        report << "Thistlethwaite solution (" << solution.size() << " moves, "
+               << thistlethwaite->getMicroseconds() << " us): " << algorithmToString(solution);
+        return {cube, solution, report.str()};
+    }
+
+    if (strategy == SolveStrategy::CFOP) {
+        if (!cfop) cfop = std::make_unique<CfopSolver>();
+        std::vector<Move> solution = cfop->solve(cube);
+        report << "CFOP solution (" << solution.size() << " moves, " << cfop->getMicroseconds() << " us)";
+        for (const CfopStep& step : cfop->getSteps()) {
+            report << "\n  " << step.name << ": " << algorithmToString(step.moves);
+        }
+        return {cube, solution, report.str()};
+    }
+
+    if (strategy == SolveStrategy::OPTIMAL) {
+        // The pattern databases are built on the first solve (about a minute),
+        // which solveCancel stops as it does the search; deep positions can
+        // take far longer than that, so give up after 10 s
+        if (!optimal) {
+            if (!patternDatabases(&solveCancel)) return {cube, {}, "Optimal solver's table build cancelled"};
+            OptimalOptions options{20, 10000};
+            options.cancel = &solveCancel;
+            optimal = std::make_unique<OptimalSolver>(options);
+        }
+        OptimalResult result = optimal->solve(cube);
+        report << "Optimal search: " << result.nodes << " nodes, "
+               << result.nodesPerSecond() / 1e6 << " M nodes/s, lower bound " << result.lowerBound << "\n";
+        if (result.solved) {
+            report << "Optimal solution (" << result.moves.size() << " moves): " << algorithmToString(result.moves);
+            return {cube, result.moves, report.str()};
+        }
+        if (solveCancel) return {cube, {}, report.str() + "Optimal search cancelled"};
+        report << "Optimal search timed out, using the two-phase solver\n";
+    }
+
+    if (strategy == SolveStrategy::BIDIRECTIONAL) {
+        // Meant for short scrambles: a 12 move position already takes a few
+        // seconds and some 400 MB, so anything deeper goes to two-phase
+        if (!bidirectional) {
+            bidirectional = std::make_unique<BidirectionalSolver>(BidirectionalOptions{12, 24000000, 5000});
+        }
+        BidirectionalResult result = bidirectional->solve(cube);
+        report << "Meet-in-the-middle search: " << result.states << " states, " << result.milliseconds
+               << " ms, lower bound " << result.lowerBound << "\n";
+        if (result.solved) {
+            report << "Optimal solution (" << result.moves.size() << " moves): " << algorithmToString(result.moves);
+            return {cube, result.moves, report.str()};
+        }
+        report << "Scramble too deep for meet-in-the-middle, using the two-phase solver\n";
+    }
+
+    // The tables are built on the first solve, which takes a moment. The
+    // search runs from all three axes and the inverse at once.
+    if (!twoPhase) {
+        TwoPhaseOptions options;
+        options.race = true;
+        options.cancel = &solveCancel;
+        twoPhase = std::make_unique<TwoPhaseSolver>(options);
+    }
+    std::vector<Move> solution = twoPhase->solve(cube);
+    report << "Two-phase solution (" << solution.size() << " moves, "
+           << twoPhase->getMilliseconds() << " ms): " << algorithmToString(solution);
+    return {cube, solution, report.str()};
+}
+
+// Plays the worker's solution once it is ready
+void Engine::pollComputedSolve() {
+    if (pendingSolve.wait_for(std::chrono::seconds(0)) != std::future_status::ready) return;
+    // A turn still animating is not in the state yet; compare once it is
+    if (rubiksCube->isRotating() || isScrambling) return;
+    ComputedSolve solve = pendingSolve.get();
+    std::cout << solve.report << std::endl;
+    // Turning or scrambling the cube meanwhile makes the solution stale
+    if (!(CubieCube::fromCubeState(rubiksCube->getState()) == solve.cube)) {
+        if (solve.anytime) anytime->requestCancel();
+        std::cout << "The cube moved during the search; press SPACE to solve again" << std::endl;
+        return;
+    }
+    if (solve.anytime) {
+        anytimePlayed.clear();
+        anytimeActive = !solve.moves.empty();
+    }
+    queueSolution(solve.moves);
+}
+
+// Switches to the newest anytime solution when it finishes sooner than the
+// rest of the current plan. The moves already played are undone first; up
+// to the point where the two plans diverge that cancels out, so a plan that
+// starts the same way just continues.
+void Engine::adoptAnytimeImprovement() {
+    if (solutionMoves.empty()) {
+        // Solved; nothing left to improve. The search stops in the
+        // background rather than being waited for here.
+        anytime->requestCancel();
+        anytimeActive = false;
+        return;
+    }
+    std::vector<Move> better;
+    if (!anytime->takeImprovement(better)) return;
+
+    std::vector<Move> plan;
+    for (auto it = anytimePlayed.rbegin(); it != anytimePlayed.rend(); ++it) plan.push_back(inverseMove(*it));
+    plan.insert(plan.end(), better.begin(), better.end());
+    plan = simplifyMoves(plan);
+
+    size_t quarterTurns = 0;
+    for (Move m : plan) quarterTurns += movePower(m) == 2 ? 2 : 1;
+    std::cout << "Anytime: " << better.size() << " move solution after " << anytime->getImprovedAfterMs() << " ms"
+              << (anytime->isOptimal() ? " (optimal)" : "");
+    if (quarterTurns >= solutionMoves.size()) {
+        std::cout << ", too late to help" << std::endl;
+        return;
+    }
+    std::cout << ", " << quarterTurns << " quarter turns left instead of " << solutionMoves.size() << std::endl;
+    std::queue<std::string>().swap(solutionMoves);
+    queueSolution(plan);
+}
+
+void Engine::queueSolution(const std::vector<Move>& solution) {
+    // executeMove only takes quarter turns, so half turns are played twice
+    for (Move m : solution) {
+        std::string face = moveToString(makeMove(moveFace(m), 1));
+        if (movePower(m) == 3) {
+            solutionMoves.push(face + "'");
+        } else {
+            for (int i = 0; i < movePower(m); i++) solutionMoves.push(face);
+        }
+    }
+}
+
 // void RubiksCube::printAllCubelets() const {
     // std::cout << "=== ALL CUBELETS DEBUG ===" << std::endl;
     // for (const auto& piece : cubelet) {
@@ -2,6 +2,8 @@
 #define GRAPHICS_ENGINE_H
 
 #include <GLFW/glfw3.h>
+#include <atomic>
+#include <future>
 #include <iostream>
 #include <memory>
 #include <queue>
@@ -12,7 +14,14 @@
 #include "RubiksCube.h"
 #include "shapes/cubelet.h"
 #include "shader/shaderManager.h"
-#include "Solver.h"
+#include "core/Solver.h"
+#include "core/AnytimeSolver.h"
+#include "core/BidirectionalSolver.h"
+#include "core/CfopSolver.h"
+#include "core/OptimalSolver.h"
+#include "core/Simplify.h"
+#include "core/ThistlethwaiteSolver.h"
+#include "core/TwoPhaseSolver.h"
 
 using std::vector, std::unique_ptr, std::make_unique, glm::ortho, glm::cross,
     glm::mat4, glm::vec3, glm::vec4;
@@ -32,6 +41,40 @@ private:
 
     std::unique_ptr<Solver> cubeSolver;
 
+    // Quarter turns of a computed solution, played back one per rotation
+    std::queue<std::string> solutionMoves;
+    // Printed once the last of solutionMoves has started (a stall report)
+    std::string afterPlayback;
+
+    // Solver used by SPACE (O cycles through them)
+    enum class SolveStrategy { TWO_PHASE, OPTIMAL, THISTLETHWAITE, CFOP, BIDIRECTIONAL, ANYTIME };
+    SolveStrategy solveStrategy = SolveStrategy::TWO_PHASE;
+
+    // ANYTIME playback starts on the first solution while the search goes
+    // on; anytimePlayed is every move played since, so a shorter solution
+    // can replace the rest of the plan
+    bool anytimeActive = false;
+    std::vector<Move> anytimePlayed;
+
+    // Every search runs on a worker thread, polled by update() each frame so
+    // the window keeps drawing; solveCancel stops one early
+    struct ComputedSolve {
+        CubieCube cube;  // the position searched
+        std::vector<Move> moves;
+        std::string report;
+        bool anytime = false;  // the anytime search goes on after these moves
+    };
+    std::future<ComputedSolve> pendingSolve;
+    std::atomic<bool> solveCancel{false};
+    // Created by the worker on first use, so their table builds run there
+    // too; they go with the Engine, optimal's thread pool included
+    std::unique_ptr<TwoPhaseSolver> twoPhase;
+    std::unique_ptr<OptimalSolver> optimal;
+    std::unique_ptr<ThistlethwaiteSolver> thistlethwaite;
+    std::unique_ptr<CfopSolver> cfop;
+    std::unique_ptr<BidirectionalSolver> bidirectional;
+    std::unique_ptr<AnytimeSolver> anytime;
+
   /// @brief The actual GLFW window.
   GLFWwindow *window{};
 
@@ -140,6 +183,11 @@ public:
 
     void testSolverAccess();
     void startAutoSolve();
+    void startComputedSolve();
+    void queueSolution(const std::vector<Move>& solution);
+    void adoptAnytimeImprovement();
+    ComputedSolve searchSolution(CubieCube cube, SolveStrategy strategy);
+    void pollComputedSolve();
 };
 
 #endif // GRAPHICS_ENGINE_H
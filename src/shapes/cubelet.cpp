@@ -167,79 +167,6 @@ void Cubelet::setWorldPosition(glm::vec3 newWorldPos) {
     modelMatrix[3] = glm::vec4(worldPos, 1.0f);
 }
 
-void Cubelet::rotateAroundY(bool clockwise) {
-    // rotation around cube Y axis (U / D moves affect pieces' local colors)
-    // Cycle: FRONT -> RIGHT -> BACK -> LEFT -> FRONT   (for clockwise Y)
-    color old[6];
-    for (int i=0;i<6;++i) old[i] = face_colors[i];
-
-    if (clockwise) {
-        face_colors[FRONT] = old[LEFT];
-        face_colors[RIGHT] = old[FRONT];
-        face_colors[BACK]  = old[RIGHT];
-        face_colors[LEFT]  = old[BACK];
-        face_colors[UP]    = old[UP];
-        face_colors[DOWN]  = old[DOWN];
-    } else {
-        face_colors[FRONT] = old[RIGHT];
-        face_colors[LEFT]  = old[FRONT];
-        face_colors[BACK]  = old[LEFT];
-        face_colors[RIGHT] = old[BACK];
-        face_colors[UP]    = old[UP];
-        face_colors[DOWN]  = old[DOWN];
-    }
-}
-
-void Cubelet::rotateAroundX(bool clockwise) {
-    // rotation around X axis (R / L)
-    // Cycle: UP -> BACK -> DOWN -> FRONT -> UP   (clockwise looking +X -> -X)
-    color old[6];
-    for (int i=0;i<6;++i) old[i] = face_colors[i];
-
-    if (clockwise) {
-        // new[FRONT] = old[UP], new[DOWN] = old[FRONT], new[BACK] = old[DOWN], new[UP] = old[BACK]
-        face_colors[FRONT] = old[UP];
-        face_colors[DOWN]  = old[FRONT];
-        face_colors[BACK]  = old[DOWN];
-        face_colors[UP]    = old[BACK];
-        // LEFT and RIGHT unchanged
-        face_colors[LEFT]  = old[LEFT];
-        face_colors[RIGHT] = old[RIGHT];
-    } else {
-        // inverse cycle: FRONT -> UP -> BACK -> DOWN -> FRONT
-        face_colors[FRONT] = old[DOWN];
-        face_colors[UP]    = old[FRONT];
-        face_colors[BACK]  = old[UP];
-        face_colors[DOWN]  = old[BACK];
-        face_colors[LEFT]  = old[LEFT];
-        face_colors[RIGHT] = old[RIGHT];
-    }
-}
-
-void Cubelet::rotateAroundZ(bool clockwise) {
-    // rotation around Z axis (F / B)
-    // Cycle: UP -> RIGHT -> DOWN -> LEFT -> UP   (clockwise looking +Z -> -Z)
-    color old[6];
-    for (int i=0;i<6;++i) old[i] = face_colors[i];
-
-    if (clockwise) {
-        face_colors[RIGHT] = old[DOWN];
-        face_colors[UP]  = old[RIGHT];
-        face_colors[LEFT]  = old[UP];
-        face_colors[DOWN]    = old[LEFT];
-        face_colors[FRONT] = old[FRONT];
-        face_colors[BACK]  = old[BACK];
-    } else {
-        face_colors[RIGHT] = old[UP];
-        face_colors[DOWN]    = old[RIGHT];
-        face_colors[LEFT]  = old[DOWN];
-        face_colors[UP]  = old[LEFT];
-        face_colors[FRONT] = old[FRONT];
-        face_colors[BACK]  = old[BACK];
-    }
-}
-
-
 void Cubelet::debugColors() const {
     std::cout << "Cubelet at grid ("
               << gridPos.x << ", "
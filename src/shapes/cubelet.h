@@ -13,6 +13,7 @@
 #endif
 
 #include "../shader/shader.h"
+#include "../core/CubeState.h"
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <vector>
@@ -22,8 +23,6 @@ struct color {
     color(float r = 0.0f, float g = 0.0f, float b = 0.0f) : red(r), green(g), blue(b) {}
 };
 
-enum Face { FRONT=0, BACK=1, RIGHT=2, LEFT=3, UP=4, DOWN=5 };
-
 class CUBELET_ALIGN Cubelet {
 private:
     unsigned int VAO, VBO, EBO;
@@ -60,11 +59,8 @@ public:
     void setWorldPosition(glm::vec3 newWorldPos);
 
     color getFaceColor(Face face) const;
-
-    // Rotation
-    void rotateAroundY(bool clockwise);
-    void rotateAroundX(bool clockwise);
-    void rotateAroundZ(bool clockwise);
+    // Face colors are owned by CubeState; the render view only mirrors them
+    void setFaceColors(const std::vector<color>& colors) { face_colors = colors; }
 
     void debugColors() const; // Add this method
     void updateVertexColors(); // Update VBO with current face_colors
@@ -0,0 +1,37 @@
+// cube_alg: what an algorithm does, without replaying it on the animated cube.
+// Usage: cube_alg "R U R' U'" ["setup moves"]
+// Prints the cycles and order of the algorithm and its simplest spelling;
+// with setup moves, also the cycles and order of the conjugate (setup,
+// algorithm, setup undone). Tokens that are not moves are rejected.
+
+#include "core/CubeAlgebra.h"
+#include "core/Simplify.h"
+#include <iostream>
+
+static void describe(const std::string& name, const CubieCube& cube) {
+    std::cout << name << std::endl;
+    std::cout << "  cycles: " << cycleNotation(cube) << std::endl;
+    std::cout << "  order:  " << order(cube) << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<Move> moves, setup;
+    std::string bad;
+    if (argc < 2 || argc > 3 || !parseAlgorithm(argv[1], moves, bad) ||
+        (argc > 2 && !parseAlgorithm(argv[2], setup, bad))) {
+        if (!bad.empty()) std::cout << "Unknown move: " << bad << std::endl;
+        std::cout << "Usage: cube_alg \"<algorithm>\" [\"<setup moves>\"]" << std::endl;
+        return 1;
+    }
+
+    CubieCube alg = sequenceCube(moves);
+    describe(algorithmToString(moves), alg);
+    std::cout << "  inverse: " << cycleNotation(inverse(alg)) << std::endl;
+    std::cout << "  simplified: " << algorithmToString(simplifyMoves(moves)) << std::endl;
+
+    if (argc > 2) {
+        describe("[" + algorithmToString(setup) + ": " + algorithmToString(moves) + "]",
+                 conjugate(alg, sequenceCube(setup)));
+    }
+    return 0;
+}
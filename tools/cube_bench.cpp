@@ -0,0 +1,120 @@
+// cube_bench: move-kernel throughput of the cubecore representations.
+// Usage: cube_bench [moves]
+
+#include "core/Algorithm.h"
+#include "core/CubeBatch.h"
+#include "core/CubeState.h"
+#include "core/CubieCube.h"
+#include "core/StickerCube.h"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+// Runs fn(i) for i in [0, count) and returns millions of calls per second
+template <class Fn>
+static double measure(long count, Fn&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    for (long i = 0; i < count; i++) fn(i);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return count / elapsed.count() / 1e6;
+}
+
+static void report(const std::string& name, double mps, double baseline) {
+    std::cout << "  " << std::left << std::setw(34) << name << std::right << std::fixed
+              << std::setprecision(2) << std::setw(10) << mps << " M moves/s"
+              << std::setw(10) << std::setprecision(1) << mps / baseline << "x" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    long count = argc > 1 ? std::atol(argv[1]) : 20000000;
+
+    // Random quarter turns, so every representation does the same work
+    const int SEQUENCE_LENGTH = 4096;
+    std::mt19937 rng(2025);
+    std::vector<Move> moves(SEQUENCE_LENGTH);
+    struct Turn { char axis; int layer; bool clockwise; };
+    std::vector<Turn> turns(SEQUENCE_LENGTH);
+    for (int i = 0; i < SEQUENCE_LENGTH; i++) {
+        int face = rng() % 6;
+        bool prime = rng() % 2;
+        moves[i] = makeMove(face, prime ? 3 : 1);
+        CubeState::parseMove(moveToString(moves[i]), turns[i].axis, turns[i].layer, turns[i].clockwise);
+    }
+    const int mask = SEQUENCE_LENGTH - 1;
+
+    std::cout << "cube_bench: " << count << " quarter turns per kernel" << std::endl;
+
+    // Per-piece face rotation (CubeState::rotateAroundX/Y/Z), far slower, so fewer moves
+    CubeState pieces;
+    long pieceCount = count / 20 > 0 ? count / 20 : 1;
+    double baseline = measure(pieceCount, [&](long i) {
+        const Turn& t = turns[i & mask];
+        pieces.applyTurn(t.axis, t.layer, t.clockwise);
+    });
+    report("CubeState rotateAround{X,Y,Z}", baseline, baseline);
+
+    StickerCube scalar;
+    double scalarRate = measure(count, [&](long i) { scalar.applyMoveScalar(moves[i & mask]); });
+    report("StickerCube scalar", scalarRate, baseline);
+
+    StickerCube shuffled;
+    double shuffleRate = measure(count, [&](long i) { shuffled.applyMove(moves[i & mask]); });
+    report(std::string("StickerCube ") + StickerCube::backendName(), shuffleRate, baseline);
+
+    CubieCube cubies;
+    double cubieRate = measure(count, [&](long i) { cubies.applyMove(moves[i & mask]); });
+    report("CubieCube tables", cubieRate, baseline);
+
+    // A 16-move last layer algorithm: move by move, then folded at compile time
+    static constexpr Algorithm ORIENT("R' U U R U R' U R L U U L' U' L U' L'");
+    std::vector<Move> orientMoves;
+    forEachMove(ORIENT.text, [&](Move m) { orientMoves.push_back(m); });
+    CubieCube stepwise;
+    double stepwiseRate = measure(count / ORIENT.length, [&](long) {
+        for (Move m : orientMoves) stepwise.applyMove(m);
+    }) * ORIENT.length;
+    report("Algorithm move by move", stepwiseRate, baseline);
+
+    CubieCube folded;
+    double foldedRate = measure(count / ORIENT.length, [&](long) { ORIENT.applyTo(folded); }) * ORIENT.length;
+    report("Algorithm folded (constexpr)", foldedRate, baseline);
+
+    // Many cubes at once; rates count one move on one cube
+    const int BATCH_SIZE = 4096;
+    long batchRounds = count / BATCH_SIZE > 0 ? count / BATCH_SIZE : 1;
+    CubeBatch uniform(BATCH_SIZE);
+    double uniformRate = measure(batchRounds, [&](long i) { uniform.applyMove(moves[i & mask]); }) * BATCH_SIZE;
+    report("CubeBatch same move per cube", uniformRate, baseline);
+
+    // Rotate through a few per-lane move vectors
+    std::vector<std::vector<Move>> laneMoves(8, std::vector<Move>(BATCH_SIZE));
+    for (auto& vector : laneMoves) {
+        for (Move& m : vector) m = moves[rng() & mask];
+    }
+    CubeBatch perLane(BATCH_SIZE);
+    double perLaneRate = measure(batchRounds, [&](long i) { perLane.applyMoves(laneMoves[i & 7]); }) * BATCH_SIZE;
+    report("CubeBatch own move per cube", perLaneRate, baseline);
+
+    // Keep the results alive and check the kernels agree
+    if (scalar != shuffled) {
+        std::cout << "ERROR: sticker kernels disagree" << std::endl;
+        return 1;
+    }
+    if (stepwise != folded) {
+        std::cout << "ERROR: folded algorithm disagrees with its moves" << std::endl;
+        return 1;
+    }
+    CubieCube lane;
+    for (long i = 0; i < batchRounds; i++) lane.applyMove(laneMoves[i & 7][BATCH_SIZE - 1]);
+    if (perLane.get(BATCH_SIZE - 1) != lane) {
+        std::cout << "ERROR: batch kernel disagrees with CubieCube" << std::endl;
+        return 1;
+    }
+    std::cout << "  (checksum " << (int)shuffled.facelets[4] + cubies.cp[0] + pieces.getPiece(0).pos.x
+                                       + uniform.countSolved()
+              << ")" << std::endl;
+    return 0;
+}
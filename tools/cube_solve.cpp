@@ -0,0 +1,537 @@
+// cube_solve: solve a scrambled cube headlessly and report how long it took.
+// Usage: cube_solve [--optimal | --thistlethwaite | --cfop | --bidirectional | --anytime | --beginner]
+//                   "<scramble>"
+// Prints the two-phase solution of the position the scramble leads to,
+// racing searches from every axis and the inverse. With
+// --optimal it prints a shortest one, the proven lower bound and the node
+// rate (searching on every hardware thread); with --thistlethwaite the four-phase solution and its phase lengths;
+// with --cfop the cross, F2L pairs and last layer algorithms step by step;
+// with --bidirectional a shortest one found without tables, for short
+// scrambles; with --anytime every improvement of the anytime solver over
+// ten seconds, as it is found; with --beginner the layer-by-layer method of
+// the animated cube's SHIFT+SPACE solve, in quarter turns, or where it stalls. A scramble with anything but face and slice
+// turns in it is rejected.
+// cube_solve --check [count] solves count random scrambles (half of them
+// with slice turns) with the two-phase, Thistlethwaite and CFOP solvers and
+// checks that every solution solves its cube with face turns only, that the
+// beginner method's moves lead where it says (solved, or stalled) and that
+// it solves a fixed set of scrambles it handles, that
+// simplifyMoves keeps face turns face turns and that CubeState's running
+// hash matches one computed from scratch after every turn. It also solves
+// count scrambles of up to five moves bidirectionally and compares the
+// length with a brute-force search, checks edge group coordinates of up to
+// eight edges through unrankEdgeGroup and back, checks that mapTableFile rejects
+// truncated, corrupted and mismatched table files, and checks the symmetry
+// classes (counts, every coordinate's round trip through its class) and the
+// two-phase tables reduced by them against unreduced ones, and that CFOP
+// takes one algorithm for every OLL and every PLL case. When the pattern
+// database files are in the table directory it also checks optimal
+// solutions of short scrambles against the bidirectional search, which
+// cube_solve --check-optimal [count] does on its own, building the
+// databases first when they are missing. Exits 1 on any failure.
+
+#include "core/AnytimeSolver.h"
+#include "core/BidirectionalSolver.h"
+#include "core/CfopSolver.h"
+#include "core/Coordinates.h"
+#include "core/CubeAlgebra.h"
+#include "core/OptimalSolver.h"
+#include "core/PruningTable.h"
+#include "core/Simplify.h"
+#include "core/Solver.h"
+#include "core/Symmetry.h"
+#include "core/TableFile.h"
+#include "core/ThistlethwaiteSolver.h"
+#include "core/TwoPhaseSolver.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <thread>
+
+static double millisecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static bool faceTurnsOnly(const std::vector<Move>& moves) {
+    return std::all_of(moves.begin(), moves.end(), [](Move m) { return m < FACE_MOVE_COUNT; });
+}
+
+// The cube after moves is solved, up to a whole-cube rotation
+static bool solves(CubieCube cube, const std::vector<Move>& moves) {
+    for (Move m : moves) cube.applyMove(m);
+    cube.multiply(symmetryTables().cubes[centerRotation(cube)]);
+    return cube.isSolved();
+}
+
+// The move as quarter turns in executeMove notation, as the beginner solver
+// and CubeState take them
+static void applyQuarterTurns(CubeState& state, Move m) {
+    std::string face = moveToString(makeMove(moveFace(m), 1));
+    if (movePower(m) == 3) {
+        state.applyMove(face + "'");
+    } else {
+        for (int i = 0; i < movePower(m); i++) state.applyMove(face);
+    }
+}
+
+// Whether face turns solve the cube within depth, by plain depth-first search
+static bool solvableWithin(const CubieCube& cube, int depth, int last) {
+    if (cube.isSolved()) return true;
+    if (depth == 0) return false;
+    for (int m = 0; m < FACE_MOVE_COUNT; m++) {
+        if (last >= 0 && isRedundantAfter(Move(last), Move(m))) continue;
+        CubieCube next = cube;
+        next.applyMove(Move(m));
+        if (solvableWithin(next, depth - 1, m)) return true;
+    }
+    return false;
+}
+
+// Scrambles the beginner method takes through every step. It has no
+// algorithm for some last layer corner cases yet, so most random scrambles
+// stall in its last step; these must not.
+static const char* BEGINNER_SCRAMBLES[] = {
+    "L D'",
+    "U' L B'",
+    "F D2 R' L F2 B2",
+    "F' B U' L F2 U D2",
+    "F D' R' F2 L' U D' B D R' U' R2 D' L2 B R",
+    "B U2 D B2 R2 B D2 R2 L' D' F' D2 L' D'",
+};
+
+// Whether the beginner solution, replayed on the state, ends where the
+// solver says it did: solved, or stalled short of it
+static bool beginnerReplays(Solver& solver, const CubeState& state) {
+    std::vector<std::string> moves = solver.computeSolution(state);
+    CubeState replay = state;
+    for (const std::string& move : moves) {
+        if (!replay.applyMove(move)) return false;
+    }
+    return replay.isSolvedUpToRotation() == !solver.isFailed();
+}
+
+// Whether edge group coordinates of every size come back from unrankEdgeGroup,
+// the eight-edge ones past 32 bits included
+static bool edgeGroupsChecked(std::mt19937& rng) {
+    bool ok = true;
+    for (int n = 1; n <= 8; n++) {
+        std::uniform_int_distribution<uint64_t> index(0, edgeGroupCount(n) - 1);
+        for (int k = 0; k < 1000; k++) {
+            uint64_t i = k == 0 ? edgeGroupCount(n) - 1 : index(rng);
+            uint8_t states[8];
+            unrankEdgeGroup(i, states, n);
+            if (rankEdgeGroup(states, n) != i) {
+                std::cout << "FAILED edge group of " << n << ": " << i << std::endl;
+                ok = false;
+                break;
+            }
+        }
+    }
+    return ok;
+}
+
+// Whether mapTableFile takes a small table back and turns it down once it is
+// truncated, corrupted or described differently
+static bool tableFilesChecked() {
+    std::string path = (std::filesystem::temp_directory_path() / "cube_solve_check.tbl").string();
+    TableFileInfo info;
+    info.coordinate = "check";
+    info.generator = "cube_solve --check";
+    info.states = 10000;
+    info.moveCount = FACE_MOVE_COUNT;
+    std::vector<uint8_t> entries(tableFileBytes(info));
+    for (size_t i = 0; i < entries.size(); i++) entries[i] = (uint8_t)(i * 37);
+
+    auto patch = [&](size_t offset) {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekg(offset);
+        char byte = (char)file.get();
+        file.seekp(offset);
+        file.put((char)(byte ^ 1));
+    };
+    bool ok = true;
+    auto expect = [&](bool accepted, const TableFileInfo& as, const char* what) {
+        if ((mapTableFile(path, as) != nullptr) == accepted) return;
+        std::cout << "FAILED table file: " << what << (accepted ? " rejected" : " accepted") << std::endl;
+        ok = false;
+    };
+
+    if (!writeTableFile(path, info, entries.data())) {
+        std::cout << "FAILED table file: could not write " << path << std::endl;
+        return false;
+    }
+    expect(true, info, "intact file");
+    size_t size = (size_t)std::filesystem::file_size(path);  // the entries end the file
+    TableFileInfo other = info;
+    other.goal = 1;
+    expect(false, other, "file with another goal");
+    other = info;
+    other.coordinate = "other";
+    expect(false, other, "file with another coordinate");
+    patch(8);  // the format version, after the magic
+    expect(false, info, "file of another version");
+    patch(8);
+    patch(size - 1);
+    expect(false, info, "corrupted file");
+    patch(size - 1);
+    std::filesystem::resize_file(path, size - 1);
+    expect(false, info, "truncated file");
+    std::filesystem::remove(path);
+    return ok;
+}
+
+// Whether the symmetry classes have the expected counts, every coordinate
+// comes back as its representative conjugated by its symmetry, and the
+// class-reduced two-phase tables give the distances of tables over every
+// coordinate
+static bool symmetryClassesChecked() {
+    const CoordinateTables& t = coordinateTables();
+    const TwoPhaseTables& tables = twoPhaseTables();
+    const SymmetryClasses& flipSlice = flipSliceClasses();
+    const SymmetryClasses& cornerPerm = cornerPermClasses();
+    bool ok = true;
+    auto expect = [&](bool passed, const char* what) {
+        if (!passed) std::cout << "FAILED symmetry classes: " << what << std::endl;
+        ok = ok && passed;
+    };
+
+    expect(flipSlice.representative.size() == FLIPSLICE_CLASS_COUNT, "flipslice class count");
+    expect(cornerPerm.representative.size() == CORNER_PERM_CLASS_COUNT, "corner permutation class count");
+    bool roundTrip = true;
+    for (uint32_t x = 0; x < (uint32_t)FLIP_COUNT * SLICE_COUNT; x++) {
+        CubieCube c;
+        uint32_t representative = flipSlice.representative[flipSlice.classOf[x]];
+        unrankSlice(c, representative / FLIP_COUNT);
+        unrankFlip(c, representative % FLIP_COUNT);
+        c = symConjugate(c, flipSlice.symOf[x]);
+        roundTrip = roundTrip && rankFlip(c) + FLIP_COUNT * rankSlice(c) == x;
+    }
+    expect(roundTrip, "flipslice round trip");
+    roundTrip = true;
+    for (uint32_t x = 0; x < CORNER_PERM_COUNT; x++) {
+        CubieCube c;
+        unrankCornerPerm(c, cornerPerm.representative[cornerPerm.classOf[x]]);
+        roundTrip = roundTrip && rankCornerPerm(symConjugate(c, cornerPerm.symOf[x])) == x;
+    }
+    expect(roundTrip, "corner permutation round trip");
+
+    PruningTable full((size_t)FLIP_COUNT * SLICE_COUNT);
+    full.generate(0, FACE_MOVE_COUNT, [&](size_t i, int m) {
+        return t.flipMove[i % FLIP_COUNT][m] + (size_t)FLIP_COUNT * t.sliceMove(i / FLIP_COUNT, Move(m));
+    });
+    bool same = true;
+    for (size_t i = 0; i < full.size(); i++) {
+        same = same && full.get(i) == tables.flipSliceDistance(i % FLIP_COUNT, i / FLIP_COUNT);
+    }
+    expect(same, "flipslice distances");
+    full = PruningTable((size_t)CORNER_PERM_COUNT * SLICE_PERM_COUNT);
+    full.generate(0, PHASE2_MOVE_COUNT, [&](size_t i, int k) {
+        return t.cornerPermMove[i % CORNER_PERM_COUNT][PHASE2_MOVES[k]]
+             + (size_t)CORNER_PERM_COUNT * t.slicePermMove[i / CORNER_PERM_COUNT][k];
+    });
+    same = true;
+    for (size_t i = 0; i < full.size(); i++) {
+        same = same && full.get(i) == tables.cornerSlicePermDistance(i % CORNER_PERM_COUNT, i / CORNER_PERM_COUNT);
+    }
+    expect(same, "corner and slice permutation distances");
+    return ok;
+}
+
+// Whether the pattern database files are in tableDirectory(), so the optimal
+// solver can start without a build of about a minute
+static bool patternDatabaseFilesPresent() {
+    for (const char* name : {"corners", "edgesA", "edgesB"}) {
+        std::string path = tableDirectory() + "/" + name + ".tbl";
+        if (!mapTableFile(path, patternDatabaseInfo(name), false)) return false;
+    }
+    return true;
+}
+
+// Solves count scrambles of up to ten moves optimally and compares the
+// length with the bidirectional search (and, up to five moves, brute force).
+// Alternating one and four threads and split depths 0..3 takes the search
+// through the serial path and through subtrees shared out and stolen, and
+// every length goes through the mod 3 decoding of the databases.
+static int optimalFailures(int count) {
+    std::mt19937 rng(2026);
+    BidirectionalSolver bidirectional;
+    int failures = 0;
+    for (int i = 0; i < count; i++) {
+        std::vector<Move> scramble(1 + i % 10);
+        for (Move& m : scramble) m = Move(rng() % FACE_MOVE_COUNT);
+        CubieCube cube = sequenceCube(scramble);
+
+        OptimalOptions options;
+        options.threads = i % 2 == 0 ? 1 : 4;
+        options.splitDepth = i % 4;
+        OptimalResult result = OptimalSolver(options).solve(cube);
+        BidirectionalResult shortest = bidirectional.solve(cube);
+        int length = (int)result.moves.size();
+        if (!result.solved || !solves(cube, result.moves) || !faceTurnsOnly(result.moves) ||
+            result.lowerBound != length || !shortest.solved || (int)shortest.moves.size() != length ||
+            (length > 0 && length <= 5 && solvableWithin(cube, length - 1, -1))) {
+            std::cout << "FAILED optimal: " << algorithmToString(scramble) << " (" << length << " moves, "
+                      << shortest.moves.size() << " bidirectional)" << std::endl;
+            failures++;
+        }
+    }
+    return failures;
+}
+
+static int check(int count) {
+    std::mt19937 rng(2024);
+    TwoPhaseSolver twoPhase;
+    ThistlethwaiteSolver thistlethwaite;
+    CfopSolver cfop;
+    BidirectionalSolver bidirectional;
+    Solver beginner;
+    beginner.setVerbose(false);
+    int failures = 0;
+    for (int i = 0; i < count; i++) {
+        bool slices = i % 2 == 1;
+        std::vector<Move> scramble(25);
+        for (Move& m : scramble) m = Move(rng() % (slices ? MOVE_COUNT : FACE_MOVE_COUNT));
+        CubieCube cube = sequenceCube(scramble);
+
+        std::vector<const char*> failed;
+        std::vector<Move> simplified = simplifyMoves(scramble);
+        if (sequenceCube(simplified) != cube || (!slices && !faceTurnsOnly(simplified))) failed.push_back("simplify");
+        std::vector<Move> solution = twoPhase.solve(cube);
+        if (!solves(cube, solution) || !faceTurnsOnly(solution)) failed.push_back("two-phase");
+        solution = thistlethwaite.solve(cube);
+        if (!solves(cube, solution) || !faceTurnsOnly(solution)) failed.push_back("thistlethwaite");
+        solution = cfop.solve(cube);
+        if (!solves(cube, solution) || !faceTurnsOnly(solution)) failed.push_back("cfop");
+
+        // The scramble and back again, turn by turn
+        CubeState state;
+        bool hashOk = true;
+        for (Move m : scramble) {
+            applyQuarterTurns(state, m);
+            hashOk = hashOk && state.getHash() == state.computeHash();
+        }
+        for (auto m = scramble.rbegin(); m != scramble.rend(); ++m) {
+            applyQuarterTurns(state, inverseMove(*m));
+            hashOk = hashOk && state.getHash() == state.computeHash();
+        }
+        if (!hashOk || state.getHash() != CubeState().getHash()) failed.push_back("hash");
+
+        CubeState scrambled;
+        for (Move m : scramble) applyQuarterTurns(scrambled, m);
+        if (!beginnerReplays(beginner, scrambled)) failed.push_back("beginner");
+
+        for (const char* name : failed) {
+            std::cout << "FAILED " << name << ": " << algorithmToString(scramble) << std::endl;
+        }
+        failures += (int)failed.size();
+
+        // A short scramble, so a brute-force search can tell the optimal length
+        std::vector<Move> shortScramble(1 + i % 5);
+        for (Move& m : shortScramble) m = Move(rng() % FACE_MOVE_COUNT);
+        CubieCube shortCube = sequenceCube(shortScramble);
+        BidirectionalResult result = bidirectional.solve(shortCube);
+        int length = (int)result.moves.size();
+        if (!result.solved || !solves(shortCube, result.moves) || !faceTurnsOnly(result.moves) ||
+            (length > 0 && solvableWithin(shortCube, length - 1, -1))) {
+            std::cout << "FAILED bidirectional: " << algorithmToString(shortScramble) << std::endl;
+            failures++;
+        }
+    }
+    for (const char* text : BEGINNER_SCRAMBLES) {
+        std::vector<Move> scramble;
+        std::string badToken;
+        CubeState state;
+        if (parseAlgorithm(text, scramble, badToken)) {
+            for (Move m : scramble) applyQuarterTurns(state, m);
+        }
+        if (!beginnerReplays(beginner, state) || beginner.isFailed() || scramble.empty()) {
+            std::cout << "FAILED beginner: " << text << std::endl;
+            failures++;
+        }
+    }
+    if (patternDatabaseFilesPresent()) {
+        failures += optimalFailures(count / 4 + 1);
+    } else {
+        std::cout << "check:    no pattern database files in " << tableDirectory()
+                  << ", optimal solver not checked (see --check-optimal)" << std::endl;
+    }
+    if (!edgeGroupsChecked(rng)) failures++;
+    if (!tableFilesChecked()) failures++;
+    if (!symmetryClassesChecked()) failures++;
+    CfopLookCounts looks = cfopLastLayerLooks();
+    if (looks.ollStates != 216 || looks.ollLooks != 1 || looks.pllStates != 288 || looks.pllLooks != 1) {
+        std::cout << "FAILED cfop last layer: " << looks.ollStates << " OLL states in up to " << looks.ollLooks
+                  << " looks, " << looks.pllStates << " PLL states in up to " << looks.pllLooks << std::endl;
+        failures++;
+    }
+    std::cout << "check:    " << count << " scrambles, " << failures << " failures" << std::endl;
+    return failures == 0 ? 0 : 1;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc >= 2 && std::strcmp(argv[1], "--check") == 0) return check(argc > 2 ? std::atoi(argv[2]) : 200);
+    if (argc >= 2 && std::strcmp(argv[1], "--check-optimal") == 0) {
+        int count = argc > 2 ? std::atoi(argv[2]) : 50;
+        auto start = std::chrono::steady_clock::now();
+        patternDatabases();
+        std::cout << "tables:   " << millisecondsSince(start) << " ms" << std::endl;
+        int failures = optimalFailures(count);
+        std::cout << "check:    " << count << " optimal solves, " << failures << " failures" << std::endl;
+        return failures == 0 ? 0 : 1;
+    }
+
+    const char* strategy = argc > 2 ? argv[1] : "";
+    bool optimal = std::strcmp(strategy, "--optimal") == 0;
+    bool thistlethwaite = std::strcmp(strategy, "--thistlethwaite") == 0;
+    bool cfop = std::strcmp(strategy, "--cfop") == 0;
+    bool bidirectional = std::strcmp(strategy, "--bidirectional") == 0;
+    bool anytime = std::strcmp(strategy, "--anytime") == 0;
+    bool beginner = std::strcmp(strategy, "--beginner") == 0;
+    // The scramble is always the last argument; one that looks like an option
+    // (--help, or a strategy with no scramble after it) is not a scramble
+    bool scrambleGiven = argc >= 2 && std::strncmp(argv[argc - 1], "--", 2) != 0;
+    std::vector<Move> scramble;
+    std::string bad;
+    if (argc < 2 || argc > 3 || !scrambleGiven || !parseAlgorithm(argv[argc - 1], scramble, bad) ||
+        (argc == 3 && !optimal && !thistlethwaite && !cfop && !bidirectional && !anytime && !beginner)) {
+        if (!bad.empty()) std::cout << "Unknown move in scramble: " << bad << std::endl;
+        std::cout << "Usage: cube_solve [--optimal | --thistlethwaite | --cfop | --bidirectional | --anytime"
+                  << " | --beginner]"
+                  << " \"<scramble>\"" << std::endl;
+        return 1;
+    }
+
+    CubieCube cube;
+    for (Move m : scramble) cube.applyMove(m);
+
+    auto start = std::chrono::steady_clock::now();
+    if (optimal) {
+        // Everything the search reads, so its time is the search alone
+        symmetryTables();
+        coordinateTables();
+        patternDatabases();
+        std::cout << "tables:   " << millisecondsSince(start) << " ms" << std::endl;
+
+        OptimalSolver solver;
+        OptimalResult result = solver.solve(cube);
+        if (result.solved) {
+            std::cout << "solution: " << algorithmToString(result.moves) << " (" << result.moves.size()
+                      << " moves, optimal)" << std::endl;
+        } else if (result.stopped) {
+            std::cout << "solution: none, stopped" << std::endl;
+        } else {
+            std::cout << "solution: none within maxDepth" << std::endl;
+        }
+        std::cout << "bound:    " << result.lowerBound << std::endl;
+        std::cout << "search:   " << result.milliseconds << " ms, " << result.nodes << " nodes, "
+                  << result.lookups << " table lookups, " << result.nodesPerSecond() / 1e6
+                  << " M nodes/s on " << solver.getThreads() << " threads" << std::endl;
+        return 0;
+    }
+
+    if (thistlethwaite) {
+        size_t bytes = thistlethwaiteTableBytes();
+        std::cout << "tables:   " << millisecondsSince(start) << " ms, " << bytes / 1024 << " KB" << std::endl;
+
+        ThistlethwaiteSolver solver;
+        std::vector<Move> solution = solver.solve(cube);
+        const auto& phases = solver.getPhaseLengths();
+        std::cout << "solution: " << algorithmToString(solution) << " (" << solution.size() << " moves)" << std::endl;
+        std::cout << "phases:   " << phases[0] << " + " << phases[1] << " + " << phases[2] << " + "
+                  << phases[3] << std::endl;
+        std::cout << "search:   " << solver.getMicroseconds() << " us" << std::endl;
+        return 0;
+    }
+
+    if (cfop) {
+        size_t bytes = cfopTableBytes();
+        std::cout << "tables:   " << millisecondsSince(start) << " ms, " << bytes / 1024 << " KB" << std::endl;
+
+        CfopSolver solver;
+        std::vector<Move> solution = solver.solve(cube);
+        for (const CfopStep& step : solver.getSteps()) {
+            std::cout << "  " << step.name << ": " << algorithmToString(step.moves) << std::endl;
+        }
+        std::cout << "solution: " << algorithmToString(solution) << " (" << solution.size() << " moves)" << std::endl;
+        std::cout << "search:   " << solver.getMicroseconds() << " us" << std::endl;
+        return 0;
+    }
+
+    if (bidirectional) {
+        BidirectionalSolver solver;
+        BidirectionalResult result = solver.solve(cube);
+        if (result.solved) {
+            std::cout << "solution: " << algorithmToString(result.moves) << " (" << result.moves.size()
+                      << " moves, optimal)" << std::endl;
+        } else {
+            std::cout << "solution: none within the state budget" << std::endl;
+        }
+        std::cout << "bound:    " << result.lowerBound << std::endl;
+        std::cout << "search:   " << result.milliseconds << " ms, " << result.states << " states stored, "
+                  << result.probes << " probes" << std::endl;
+        return 0;
+    }
+
+    if (beginner) {
+        // The beginner solver works on the sticker state in quarter turns
+        CubeState state;
+        for (Move m : scramble) applyQuarterTurns(state, m);
+
+        Solver solver;
+        solver.setVerbose(false);
+        std::vector<std::string> solution = solver.computeSolution(state);
+        double microseconds = millisecondsSince(start) * 1000;
+        if (solver.isFailed()) {
+            std::cout << "solution: none, stalled in step " << solver.getCurrentStep() << " after "
+                      << solution.size() << " quarter turns" << std::endl;
+        } else {
+            std::string text;
+            for (const std::string& move : solution) text += (text.empty() ? "" : " ") + move;
+            std::cout << "solution: " << text << " (" << solution.size() << " quarter turns)" << std::endl;
+        }
+        std::cout << "search:   " << microseconds << " us" << std::endl;
+        return solver.isFailed() ? 1 : 0;
+    }
+
+    if (anytime) {
+        twoPhaseTables();
+        thistlethwaiteTables();
+        symmetryTables();
+        coordinateTables();
+        patternDatabases();
+        std::cout << "tables:   " << millisecondsSince(start) << " ms" << std::endl;
+
+        AnytimeSolver solver(AnytimeOptions{10000, 1000, true});
+        std::vector<Move> solution = solver.start(cube);
+        std::cout << "first:    " << algorithmToString(solution) << " (" << solution.size() << " moves, "
+                  << solver.getImprovedAfterMs() << " ms)" << std::endl;
+        for (;;) {
+            bool searching = solver.isSearching();
+            if (solver.takeImprovement(solution)) {
+                std::cout << "better:   " << algorithmToString(solution) << " (" << solution.size() << " moves, "
+                          << solver.getImprovedAfterMs() << " ms)" << std::endl;
+            }
+            if (!searching) break;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        std::cout << (solver.isOptimal() ? "proven optimal" : "deadline reached") << std::endl;
+        return 0;
+    }
+
+    twoPhaseTables();
+    std::cout << "tables:   " << millisecondsSince(start) << " ms" << std::endl;
+
+    TwoPhaseOptions options;
+    options.race = true;
+    TwoPhaseSolver solver(options);
+    std::vector<Move> solution = solver.solve(cube);
+    std::cout << "solution: " << algorithmToString(solution) << " (" << solution.size() << " moves)" << std::endl;
+    std::cout << "search:   " << solver.getMilliseconds() << " ms, " << solver.getNodes()
+              << " nodes over six searches (three axes, cube and inverse)" << std::endl;
+    return 0;
+}
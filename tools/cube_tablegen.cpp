@@ -0,0 +1,140 @@
+// cube_tablegen: build a pattern database by breadth-first expansion on all
+// hardware threads and write it to a file.
+// Usage: cube_tablegen [--threads N] [--check] <corners | edgesA | edgesB | edges7 | edges8> [file]
+// Tables hold 2 bits per state (distance mod 3, see Mod3PruningTable):
+//   corners  corner permutation x twist, 88 M states, 22 MB
+//   edgesA   edges UR..DF as in the optimal solver, 43 M states, 11 MB
+//   edgesB   edges DL..BR, likewise
+//   edges7   edges UR..BL, 511 M states, 128 MB
+//   edges8   edges UR..FR, 5.1 G states, 1.2 GB (and 1.9 GB of bitsets
+//            while it is built; --check needs as much again)
+// Prints the states found at each depth and the rate. With --check the table
+// is built again on one thread with Mod3PruningTable::generate and compared.
+// The file is a table file (see TableFile.h) the solvers can map directly.
+
+#include "core/Coordinates.h"
+#include "core/OptimalSolver.h"
+#include "core/TableFile.h"
+#include "core/TableGenerator.h"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <string>
+
+static double millisecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+struct TableSpec {
+    TableFileInfo info;
+    std::function<size_t(size_t, int)> next;
+};
+
+static TableSpec edgeSpec(int firstEdge, int n) {
+    uint8_t solved[8];
+    for (int i = 0; i < n; i++) solved[i] = (firstEdge + i) * 2;
+
+    TableSpec spec;
+    spec.info.coordinate = "edge group 0.." + std::to_string(n - 1) + ", slot * 2 + flip";
+    spec.info.states = edgeGroupCount(n);
+    spec.info.goal = rankEdgeGroup(solved, n);
+    spec.info.moveCount = FACE_MOVE_COUNT;
+    spec.next = [n](size_t index, int m) {
+        uint8_t states[8];
+        unrankEdgeGroup(index, states, n);
+        for (int i = 0; i < n; i++) states[i] = EDGE_STATE_MOVES[states[i]][m];
+        return (size_t)rankEdgeGroup(states, n);
+    };
+    return spec;
+}
+
+static bool tableSpec(const std::string& name, TableSpec& spec) {
+    if (name == "corners") {
+        const CoordinateTables& t = coordinateTables();
+        spec.info = patternDatabaseInfo(name);
+        spec.next = [&t](size_t index, int m) {
+            size_t perm = index / TWIST_COUNT, twist = index % TWIST_COUNT;
+            return t.cornerPermMove[perm][m] * (size_t)TWIST_COUNT + t.twistMove[twist][m];
+        };
+    } else if (name == "edgesA") {
+        spec = edgeSpec(0, EDGE_GROUP_SIZE);
+        spec.info = patternDatabaseInfo(name);
+    } else if (name == "edgesB") {
+        spec = edgeSpec(EDGE_GROUP_SIZE, EDGE_GROUP_SIZE);
+        spec.info = patternDatabaseInfo(name);
+    } else if (name == "edges7") {
+        spec = edgeSpec(0, 7);
+    } else if (name == "edges8") {
+        spec = edgeSpec(0, 8);
+    } else {
+        return false;
+    }
+    spec.info.generator = "cube_tablegen";
+    spec.info.bitsPerEntry = 2;
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    int threads = 0;
+    bool check = false;
+    int arg = 1;
+    for (; arg < argc && argv[arg][0] == '-'; arg++) {
+        if (std::strcmp(argv[arg], "--threads") == 0 && arg + 1 < argc) {
+            threads = std::atoi(argv[++arg]);
+        } else if (std::strcmp(argv[arg], "--check") == 0) {
+            check = true;
+        } else {
+            break;
+        }
+    }
+
+    TableSpec spec;
+    if (arg >= argc || argc - arg > 2 || !tableSpec(argv[arg], spec)) {
+        std::cout << "Usage: cube_tablegen [--threads N] [--check] <corners | edgesA | edgesB | edges7 | edges8> [file]"
+                  << std::endl;
+        return 1;
+    }
+    const char* file = argc - arg == 2 ? argv[arg + 1] : nullptr;
+
+    const TableFileInfo& info = spec.info;
+    Mod3PruningTable table(info.states);
+    TableGenerator generator(threads);
+    auto start = std::chrono::steady_clock::now();
+    generator.generate(table, info.goal, info.moveCount, spec.next);
+    double milliseconds = millisecondsSince(start);
+
+    const std::vector<size_t>& levels = generator.levelCounts();
+    size_t reached = 0;
+    for (size_t depth = 0; depth < levels.size(); depth++) {
+        std::cout << "  depth " << depth << ": " << levels[depth] << std::endl;
+        reached += levels[depth];
+    }
+    std::cout << "states:   " << info.states << ", " << table.bytes() / 1024 << " KB" << std::endl;
+    std::cout << "time:     " << milliseconds << " ms, " << info.states / milliseconds / 1e3
+              << " M states/s on " << generator.threads() << " threads" << std::endl;
+    // Every index is a state the moves connect, so all of them are reached
+    // unless the coordinate's rank and unrank disagree
+    if (reached != info.states) {
+        std::cout << "ERROR: " << reached << " states reached" << std::endl;
+        return 1;
+    }
+
+    if (check) {
+        Mod3PruningTable serial(info.states);
+        serial.generate(info.goal, info.moveCount, spec.next);
+        bool same = std::memcmp(serial.raw(), table.raw(), table.bytes()) == 0;
+        std::cout << "check:    " << (same ? "identical" : "DIFFERENT") << " to the one-thread table" << std::endl;
+        if (!same) return 1;
+    }
+
+    if (file) {
+        if (!writeTableFile(file, info, table.raw())) {
+            std::cout << "could not write " << file << std::endl;
+            return 1;
+        }
+        std::cout << "written:  " << file << std::endl;
+    }
+    return 0;
+}